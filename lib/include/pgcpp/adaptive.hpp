@@ -0,0 +1,233 @@
+#pragma once
+
+#include "interval.hpp"
+#include "parallel.hpp"
+#include "pg_common.hpp"
+#include "pg_line.hpp"
+#include "pg_point.hpp"
+#include <algorithm>
+#include <array>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+/*! @file include/adaptive.hpp
+ *  This is a C++ Library header.
+ *
+ *  Exact geometric decisions at near floating point speed. Each query is
+ *  first evaluated in interval<double>; only when the enclosure of the
+ *  deciding value contains zero is it evaluated again, exactly, in
+ *  cpp_int. The objects are homogeneous, so each one is converted exactly
+ *  by scaling its coordinates with a common power of two.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Value whose zero-ness decides point-line incidence
+ *
+ */
+struct incidence_query
+{
+    template <typename P, typename L>
+    auto operator()(const P& p, const L& l) const
+    {
+        return p.dot(l);
+    }
+};
+
+/**
+ * @brief Value whose zero-ness decides collinearity of three points
+ *
+ */
+struct collinear_query
+{
+    template <typename P>
+    auto operator()(const P& a, const P& b, const P& c) const
+    {
+        return c.dot(a * b);
+    }
+};
+
+/**
+ * @brief Value whose zero-ness decides is_parallel (Euclidean plane)
+ *
+ */
+struct parallel_query
+{
+    template <typename L>
+    auto operator()(const L& l, const L& m) const
+    {
+        return cross2(l, m);
+    }
+};
+
+/**
+ * @brief Value whose zero-ness decides is_perpendicular (Euclidean plane)
+ *
+ */
+struct perpendicular_query
+{
+    template <typename L>
+    auto operator()(const L& l, const L& m) const
+    {
+        return dot1(l, m);
+    }
+};
+
+/**
+ * @brief Statistics of an adaptive evaluation
+ *
+ */
+struct adaptive_report
+{
+    std::size_t count = 0; //!< queries evaluated
+    std::size_t fallbacks = 0; //!< queries re-evaluated exactly
+
+    /*!
+     * @brief
+     *
+     * @return fraction of the queries re-evaluated exactly
+     */
+    [[nodiscard]] auto fallback_rate() const -> double
+    {
+        return this->count == 0
+            ? 0.
+            : double(this->fallbacks) / double(this->count);
+    }
+};
+
+namespace detail
+{
+    template <typename K>
+    auto to_interval(const pg_point<double>& p) -> pg_point<K>
+    {
+        return pg_point<K> {K(p[0]), K(p[1]), K(p[2])};
+    }
+
+    template <typename K>
+    auto to_interval(const pg_line<double>& l) -> pg_line<K>
+    {
+        return pg_line<K> {K(l[0]), K(l[1]), K(l[2])};
+    }
+
+    // the coordinates times a common power of two, as integers
+    inline auto to_exact_coords(const std::array<double, 3>& v)
+        -> std::array<boost::multiprecision::cpp_int, 3>
+    {
+        using boost::multiprecision::cpp_int;
+        // v[i] = m[i] 2^e[i] with integer m[i] of at most 53 bits
+        auto m = std::array<std::int64_t, 3> {};
+        auto e = std::array<int, 3> {};
+        auto e_min = std::numeric_limits<int>::max();
+        for (auto i = 0U; i != 3; ++i)
+        {
+            assert(std::isfinite(v[i]));
+            auto exp = 0;
+            const auto frac = std::frexp(v[i], &exp);
+            m[i] = std::int64_t(std::ldexp(frac, 53));
+            e[i] = exp - 53;
+            if (m[i] != 0)
+            {
+                e_min = std::min(e_min, e[i]);
+            }
+        }
+        auto res = std::array<cpp_int, 3> {};
+        for (auto i = 0U; i != 3; ++i)
+        {
+            if (m[i] != 0)
+            {
+                res[i] = cpp_int(m[i]) << unsigned(e[i] - e_min);
+            }
+        }
+        return res;
+    }
+
+    inline auto to_exact(const pg_point<double>& p)
+        -> pg_point<boost::multiprecision::cpp_int>
+    {
+        return pg_point<boost::multiprecision::cpp_int> {to_exact_coords(p)};
+    }
+
+    inline auto to_exact(const pg_line<double>& l)
+        -> pg_line<boost::multiprecision::cpp_int>
+    {
+        return pg_line<boost::multiprecision::cpp_int> {to_exact_coords(l)};
+    }
+
+    template <typename K>
+    auto exact_sign(const K& v) -> int
+    {
+        return v > K(0) ? 1 : (v < K(0) ? -1 : 0);
+    }
+} // namespace detail
+
+/*!
+ * @brief Exact signs of a query on a batch of items, evaluated adaptively
+ *        and in parallel
+ *
+ * Each item is a tuple of pg_point<double> / pg_line<double> passed as
+ * the arguments of query, a generic callable returning the deciding
+ * value (e.g. incidence_query). sign[i] is the exact sign of that value
+ * for the objects as given in double, so e.g. item i is incident if and
+ * only if sign[i] == 0. An enclosure [0, 0] is certain, as the interval
+ * operations stay outward rounded on underflow. The coordinates must be
+ * finite.
+ *
+ * @param[in] query
+ * @param[in] items
+ * @param[out] sign
+ * @return adaptive_report
+ */
+template <typename Query, typename Item>
+auto adaptive_sign(const Query& query, std::span<const Item> items,
+    std::span<int> sign) -> adaptive_report
+{
+    using I = interval<double>;
+    assert(sign.size() == items.size());
+    auto exact = std::vector<char>(items.size());
+    parallel_for(items.size(), [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i != last; ++i)
+        {
+            const auto v = std::apply(
+                [&](const auto&... obj) {
+                    return query(detail::to_interval<I>(obj)...);
+                },
+                items[i]);
+            if (v.lo() > 0.)
+            {
+                sign[i] = 1;
+            }
+            else if (v.hi() < 0.)
+            {
+                sign[i] = -1;
+            }
+            else if (v == I(0.))
+            {
+                sign[i] = 0;
+            }
+            else
+            {
+                exact[i] = 1;
+                sign[i] = detail::exact_sign(std::apply(
+                    [&](const auto&... obj) {
+                        return query(detail::to_exact(obj)...);
+                    },
+                    items[i]));
+            }
+        }
+    });
+    auto rep = adaptive_report {};
+    rep.count = items.size();
+    rep.fallbacks = std::size_t(std::count(exact.begin(), exact.end(), 1));
+    return rep;
+}
+
+} // namespace fun
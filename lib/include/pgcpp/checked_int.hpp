@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+/*! @file include/checked_int.hpp
+ *  This is a C++ Library header.
+ *
+ *  Builtin signed integers whose arithmetic throws on overflow, e.g. to
+ *  tell a theorem that fails from one whose intermediate values do not
+ *  fit in int64_t.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Signed integer that throws std::overflow_error instead of
+ *        wrapping
+ *
+ * Satisfies Integral, so pg_point<checked_int<Z>> and
+ * Fraction<checked_int<Z>> run the same code as over Z, with each
+ * operation checked by the compiler's overflow builtins.
+ *
+ * @tparam Z builtin signed integer
+ */
+template <std::signed_integral Z>
+class checked_int
+{
+    Z _v {0};
+
+    [[noreturn]] static void overflow()
+    {
+        throw std::overflow_error("checked_int: integer overflow");
+    }
+
+  public:
+    using value_type = Z;
+
+    /*!
+     * @brief Construct zero
+     *
+     */
+    constexpr checked_int() = default;
+
+    /*!
+     * @brief Construct from an integer, which must be representable in Z
+     *
+     * @param[in] n
+     */
+    template <std::integral T>
+    constexpr checked_int(T n) // NOLINT(google-explicit-constructor)
+        : _v {static_cast<Z>(n)}
+    {
+        if (!std::in_range<Z>(n))
+        {
+            overflow();
+        }
+    }
+
+    /*!
+     * @brief
+     *
+     * @return Z
+     */
+    [[nodiscard]] constexpr auto value() const -> Z
+    {
+        return this->_v;
+    }
+
+    constexpr auto operator+=(const checked_int& b) -> checked_int&
+    {
+        if (__builtin_add_overflow(this->_v, b._v, &this->_v))
+        {
+            overflow();
+        }
+        return *this;
+    }
+
+    constexpr auto operator-=(const checked_int& b) -> checked_int&
+    {
+        if (__builtin_sub_overflow(this->_v, b._v, &this->_v))
+        {
+            overflow();
+        }
+        return *this;
+    }
+
+    constexpr auto operator*=(const checked_int& b) -> checked_int&
+    {
+        if (__builtin_mul_overflow(this->_v, b._v, &this->_v))
+        {
+            overflow();
+        }
+        return *this;
+    }
+
+    constexpr auto operator/=(const checked_int& b) -> checked_int&
+    {
+        assert(b._v != 0);
+        if (b._v == -1 && this->_v == std::numeric_limits<Z>::min())
+        {
+            overflow();
+        }
+        this->_v /= b._v;
+        return *this;
+    }
+
+    constexpr auto operator%=(const checked_int& b) -> checked_int&
+    {
+        assert(b._v != 0);
+        this->_v = (b._v == -1) ? Z(0) : Z(this->_v % b._v);
+        return *this;
+    }
+
+    constexpr auto operator-() const -> checked_int
+    {
+        return checked_int {0} -= *this;
+    }
+
+    friend constexpr auto operator+(checked_int a, const checked_int& b)
+        -> checked_int
+    {
+        return a += b;
+    }
+
+    friend constexpr auto operator-(checked_int a, const checked_int& b)
+        -> checked_int
+    {
+        return a -= b;
+    }
+
+    friend constexpr auto operator*(checked_int a, const checked_int& b)
+        -> checked_int
+    {
+        return a *= b;
+    }
+
+    friend constexpr auto operator/(checked_int a, const checked_int& b)
+        -> checked_int
+    {
+        return a /= b;
+    }
+
+    friend constexpr auto operator%(checked_int a, const checked_int& b)
+        -> checked_int
+    {
+        return a %= b;
+    }
+
+    friend constexpr auto operator==(
+        const checked_int& a, const checked_int& b) -> bool
+    {
+        return a._v == b._v;
+    }
+
+    friend constexpr auto operator<=>(
+        const checked_int& a, const checked_int& b) -> std::strong_ordering
+    {
+        return a._v <=> b._v;
+    }
+
+    template <typename Stream>
+    friend auto operator<<(Stream& os, const checked_int& a) -> Stream&
+    {
+        os << a._v;
+        return os;
+    }
+};
+
+} // namespace fun
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "exact_sqrt.hpp"
+#include "parallel.hpp"
+#include "pg_common.hpp"
+#include "proj_plane.hpp"
+#include <cassert>
+#include <optional>
+#include <span>
+#include <utility>
+
+/*! @file include/conic.hpp
+ *  This is a C++ Library header.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Conic { p : p^T M p == 0 } given by a symmetric 3x3 matrix M
+ *
+ * The matrix and its adjugate (the dual conic) are both cached, so that
+ * polar and pole are single matrix-vector products.
+ *
+ * @tparam P Point
+ * @tparam L Line
+ */
+template <typename P, typename L = typename P::dual>
+requires Projective_plane_coord<P, L>
+class conic
+{
+    using K = Value_type<P>;
+
+  public:
+    using matrix_t = Mat3<K>;
+
+  private:
+    matrix_t _mat;
+    matrix_t _adj;
+
+  public:
+    /*!
+     * @brief Construct a new conic object
+     *
+     * @param[in] mat symmetric matrix
+     */
+    constexpr explicit conic(matrix_t mat)
+        : _mat {std::move(mat)}
+        , _adj {mat3_adj(_mat)}
+    {
+    }
+
+    /*!
+     * @brief Construct the conic through five points
+     *
+     * The conic is taken from the pencil spanned by the line pairs
+     * (p1 p2)(p3 p4) and (p1 p3)(p2 p4), which all pass through p1..p4.
+     * Over an integral ring the matrix is reduced by the gcd of its entries.
+     *
+     * @param[in] p1
+     * @param[in] p2
+     * @param[in] p3
+     * @param[in] p4
+     * @param[in] p5
+     */
+    constexpr conic(
+        const P& p1, const P& p2, const P& p3, const P& p4, const P& p5)
+        : conic {five_point_matrix(p1, p2, p3, p4, p5)}
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @return const matrix_t&
+     */
+    [[nodiscard]] constexpr auto matrix() const -> const matrix_t&
+    {
+        return this->_mat;
+    }
+
+    /*!
+     * @brief adjugate matrix (dual conic)
+     *
+     * @return const matrix_t&
+     */
+    [[nodiscard]] constexpr auto adjugate() const -> const matrix_t&
+    {
+        return this->_adj;
+    }
+
+    /*!
+     * @brief polar line of a point
+     *
+     * @param[in] p
+     * @return L
+     */
+    [[nodiscard]] constexpr auto polar(const P& p) const -> L
+    {
+        return L {mat3_vec(this->_mat, p)};
+    }
+
+    /*!
+     * @brief pole of a line
+     *
+     * @param[in] l
+     * @return P
+     */
+    [[nodiscard]] constexpr auto pole(const L& l) const -> P
+    {
+        return P {mat3_vec(this->_adj, l)};
+    }
+
+    /*!
+     * @brief whether p lies on the conic
+     *
+     * @param[in] p
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] constexpr auto incident(const P& p) const -> bool
+    {
+        return dot_c(p, mat3_vec(this->_mat, p)) == K(0);
+    }
+
+    /*!
+     * @brief intersection points of a line with the conic
+     *
+     * @param[in] l
+     * @return the two (possibly equal) points, or std::nullopt if they are
+     *         not defined over K (e.g. irrational) or if l lies on the
+     *         (degenerate) conic
+     */
+    [[nodiscard]] auto meet(const L& l) const -> std::optional<std::pair<P, P>>
+    {
+        // two distinct points A, B on l
+        const auto A = (l[2] != K(0)) ? P {K(0), l[2], -l[1]}
+                                      : P {l[1], -l[0], K(0)};
+        const auto B = (l[2] != K(0)) ? P {-l[2], K(0), l[0]}
+                                      : P {K(0), K(0), K(1)};
+        // (s A + t B)^T M (s A + t B) = a s^2 + 2 b s t + c t^2
+        const auto MB = mat3_vec(this->_mat, B);
+        const auto a = dot_c(A, mat3_vec(this->_mat, A));
+        const auto b = dot_c(A, MB);
+        const auto c = dot_c(B, MB);
+        if (a == K(0))
+        {
+            if (b == K(0) && c == K(0))
+            {
+                return std::nullopt; // l lies on the (degenerate) conic
+            }
+            return std::pair {P {A}, plucker(c, A, K(-2 * b), B)};
+        }
+        auto r = exact_sqrt(K(b * b - a * c));
+        if (!r)
+        {
+            return std::nullopt;
+        }
+        return std::pair {
+            plucker(K(*r - b), A, a, B), plucker(K(-*r - b), A, a, B)};
+    }
+
+    /*!
+     * @brief tangent lines from a point
+     *
+     * If p lies on the conic, both lines are the tangent at p.
+     *
+     * @param[in] p
+     * @return the two tangents, or std::nullopt if they are not defined
+     *         over K
+     */
+    [[nodiscard]] auto tangents(const P& p) const
+        -> std::optional<std::pair<L, L>>
+    {
+        auto l = this->polar(p);
+        if (this->incident(p))
+        {
+            return std::pair {L {l}, std::move(l)};
+        }
+        auto pts = this->meet(l);
+        if (!pts)
+        {
+            return std::nullopt;
+        }
+        return std::pair {p * pts->first, p * pts->second};
+    }
+
+    /*!
+     * @brief polar lines of a batch of points
+     *
+     * @param[in] pts
+     * @param[out] out must have the same size as pts
+     */
+    void polar(std::span<const P> pts, std::span<L> out) const
+    {
+        assert(pts.size() == out.size());
+        parallel_for(pts.size(), [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                out[i] = L {mat3_vec(this->_mat, pts[i])};
+            }
+        });
+    }
+
+    /*!
+     * @brief poles of a batch of lines
+     *
+     * @param[in] lns
+     * @param[out] out must have the same size as lns
+     */
+    void pole(std::span<const L> lns, std::span<P> out) const
+    {
+        assert(lns.size() == out.size());
+        parallel_for(lns.size(), [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                out[i] = P {mat3_vec(this->_adj, lns[i])};
+            }
+        });
+    }
+
+  private:
+    static constexpr auto five_point_matrix(const P& p1, const P& p2,
+        const P& p3, const P& p4, const P& p5) -> matrix_t
+    {
+        const auto l12 = p1 * p2;
+        const auto l34 = p3 * p4;
+        const auto l13 = p1 * p3;
+        const auto l24 = p2 * p4;
+        const auto e1 = p5.dot(l12) * p5.dot(l34);
+        const auto e2 = p5.dot(l13) * p5.dot(l24);
+        auto M = matrix_t {};
+        for (auto i = 0U; i != 3; ++i)
+        {
+            for (auto j = 0U; j != 3; ++j)
+            {
+                M[i][j] = e2 * (l12[i] * l34[j] + l12[j] * l34[i]) -
+                    e1 * (l13[i] * l24[j] + l13[j] * l24[i]);
+            }
+        }
+        if constexpr (Integral<K>)
+        {
+            reduce_mat3(M);
+        }
+        return M;
+    }
+};
+
+} // namespace fun
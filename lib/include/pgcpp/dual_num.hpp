@@ -0,0 +1,243 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+
+/*! @file include/dual_num.hpp
+ *  This is a C++ Library header.
+ *
+ *  Forward-mode automatic differentiation. Running a measure over
+ *  pg_point<dual_num<double, N>> gives its value and its gradient with
+ *  respect to N seeded coordinates in one pass.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Value with its gradient with respect to N variables
+ *
+ * The gradient is a fixed-size array operated on element-wise, so the
+ * loops vectorize. It keeps the alignment of T, as a 32-byte aligned
+ * member would change how dual_num is passed by value. Comparisons only look at the values, which makes
+ * dual_num an ordered_ring (but not Integral, so the measures divide
+ * instead of forming fractions).
+ *
+ * @tparam T floating point type
+ * @tparam N number of variables
+ */
+template <typename T, std::size_t N>
+class dual_num
+{
+    std::array<T, N> _grad {};
+    T _val {};
+
+  public:
+    /*!
+     * @brief Construct zero
+     *
+     */
+    constexpr dual_num() = default;
+
+    /*!
+     * @brief Construct a constant
+     *
+     * @param[in] val
+     */
+    constexpr dual_num(T val) // NOLINT(google-explicit-constructor)
+        : _val {val}
+    {
+    }
+
+    /*!
+     * @brief Construct from a value and a gradient
+     *
+     * @param[in] val
+     * @param[in] grad
+     */
+    constexpr dual_num(T val, const std::array<T, N>& grad)
+        : _grad {grad}
+        , _val {val}
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] val
+     * @param[in] i in [0, N)
+     * @return variable i with the value val
+     */
+    static constexpr auto variable(T val, std::size_t i) -> dual_num
+    {
+        assert(i < N);
+        auto res = dual_num {val};
+        res._grad[i] = T(1);
+        return res;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return const T&
+     */
+    [[nodiscard]] constexpr auto value() const -> const T&
+    {
+        return this->_val;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return const std::array<T, N>&
+     */
+    [[nodiscard]] constexpr auto gradient() const -> const std::array<T, N>&
+    {
+        return this->_grad;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i
+     * @return partial derivative with respect to variable i
+     */
+    [[nodiscard]] constexpr auto d(std::size_t i) const -> const T&
+    {
+        return this->_grad[i];
+    }
+
+    constexpr auto operator+=(const dual_num& b) -> dual_num&
+    {
+        this->_val += b._val;
+        for (auto i = 0U; i != N; ++i)
+        {
+            this->_grad[i] += b._grad[i];
+        }
+        return *this;
+    }
+
+    constexpr auto operator-=(const dual_num& b) -> dual_num&
+    {
+        this->_val -= b._val;
+        for (auto i = 0U; i != N; ++i)
+        {
+            this->_grad[i] -= b._grad[i];
+        }
+        return *this;
+    }
+
+    constexpr auto operator*=(const dual_num& b) -> dual_num&
+    {
+        // (a b)' = a' b + a b'
+        for (auto i = 0U; i != N; ++i)
+        {
+            this->_grad[i] = this->_grad[i] * b._val + this->_val * b._grad[i];
+        }
+        this->_val *= b._val;
+        return *this;
+    }
+
+    constexpr auto operator/=(const dual_num& b) -> dual_num&
+    {
+        // (a / b)' = (a' - (a / b) b') / b
+        const auto inv = T(1) / b._val;
+        this->_val *= inv;
+        for (auto i = 0U; i != N; ++i)
+        {
+            this->_grad[i] = (this->_grad[i] - this->_val * b._grad[i]) * inv;
+        }
+        return *this;
+    }
+
+    constexpr auto operator-() const -> dual_num
+    {
+        auto res = dual_num {-this->_val};
+        for (auto i = 0U; i != N; ++i)
+        {
+            res._grad[i] = -this->_grad[i];
+        }
+        return res;
+    }
+
+    friend constexpr auto operator+(dual_num a, const dual_num& b)
+        -> dual_num
+    {
+        return a += b;
+    }
+
+    friend constexpr auto operator-(dual_num a, const dual_num& b)
+        -> dual_num
+    {
+        return a -= b;
+    }
+
+    friend constexpr auto operator*(dual_num a, const dual_num& b)
+        -> dual_num
+    {
+        return a *= b;
+    }
+
+    friend constexpr auto operator/(dual_num a, const dual_num& b)
+        -> dual_num
+    {
+        return a /= b;
+    }
+
+    friend constexpr auto operator==(const dual_num& a, const dual_num& b)
+        -> bool
+    {
+        return a._val == b._val;
+    }
+
+    friend constexpr auto operator<=>(const dual_num& a, const dual_num& b)
+    {
+        return a._val <=> b._val;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] a
+     * @return |a|
+     */
+    friend auto abs(const dual_num& a) -> dual_num
+    {
+        return a._val < T(0) ? -a : a;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] a positive
+     * @return sqrt(a)
+     */
+    friend auto sqrt(const dual_num& a) -> dual_num
+    {
+        using std::sqrt;
+        auto res = dual_num {sqrt(a._val)};
+        const auto k = T(0.5) / res._val;
+        for (auto i = 0U; i != N; ++i)
+        {
+            res._grad[i] = a._grad[i] * k;
+        }
+        return res;
+    }
+
+    template <typename Stream>
+    friend auto operator<<(Stream& os, const dual_num& a) -> Stream&
+    {
+        os << a._val << " [";
+        for (auto i = 0U; i != N; ++i)
+        {
+            os << (i == 0 ? "" : ", ") << a._grad[i];
+        }
+        os << ']';
+        return os;
+    }
+};
+
+} // namespace fun
@@ -2,6 +2,10 @@
 
 #include "euclid_plane.hpp"
 #include "fractions.hpp"
+#include "parallel.hpp"
+#include <cassert>
+#include <span>
+#include <vector>
 
 namespace fun
 {
@@ -43,6 +47,9 @@ inline constexpr auto quad1(const K& x1, const K& z1, const K& x2, const K& z2)
 /*!
  * @brief
  *
+ * For integral K the result is formed directly as
+ * ((x1 z2 - x2 z1)^2 + (y1 z2 - y2 z1)^2) / (z1 z2)^2 with a single gcd.
+ *
  * @param[in] a1
  * @param[in] a2
  * @return auto
@@ -50,8 +57,72 @@ inline constexpr auto quad1(const K& x1, const K& z1, const K& x2, const K& z2)
 template <Projective_plane_coord2 P>
 inline constexpr auto quadrance(const P& a1, const P& a2)
 {
-    return quad1(a1[0], a1[2], a2[0], a2[2]) +
-        quad1(a1[1], a1[2], a2[1], a2[2]);
+    using K = Value_type<P>;
+    if constexpr (Integral<K>)
+    {
+        return Fraction<K>(K(sq(cross1(a1, a2)) + sq(cross0(a1, a2))),
+            K(sq(a1[2] * a2[2])));
+    }
+    else
+    {
+        return quad1(a1[0], a1[2], a2[0], a2[2]) +
+            quad1(a1[1], a1[2], a2[1], a2[2]);
+    }
+}
+
+/*!
+ * @brief Quadrances between all pairs of points
+ *
+ * @param[in] pts n points
+ * @param[out] out n (n - 1) / 2 quadrances in the order (0,1), (0,2), ...,
+ *             (0,n-1), (1,2), ...
+ */
+template <Projective_plane_coord2 P, typename Q>
+void quadrance_all_pairs(std::span<const P> pts, std::span<Q> out)
+{
+    using K = Value_type<P>;
+    const auto n = pts.size();
+    assert(out.size() == n * (n - 1) / 2 || (n == 0 && out.empty()));
+    auto zz = std::vector<K>(n);
+    for (auto i = 0U; i != n; ++i)
+    {
+        zz[i] = sq(pts[i][2]);
+    }
+    // split the pairs themselves, not the rows, which shrink as i grows
+    const auto row = [n](std::size_t i) { return i * (2 * n - i - 1) / 2; };
+    parallel_for(out.size(), [&](std::size_t first, std::size_t last) {
+        // the last row i with row(i) <= first
+        auto lo = std::size_t {0};
+        auto hi = n - 1;
+        while (hi - lo > 1)
+        {
+            const auto mid = lo + (hi - lo) / 2;
+            (row(mid) <= first ? lo : hi) = mid;
+        }
+        auto i = lo;
+        auto j = i + 1 + (first - row(i));
+        for (auto k = first; k != last; ++k, ++j)
+        {
+            if (j == n)
+            {
+                ++i;
+                j = i + 1;
+            }
+            const auto& a1 = pts[i];
+            const auto& a2 = pts[j];
+            if constexpr (Integral<K>)
+            {
+                out[k] = Fraction<K>(
+                    K(sq(cross1(a1, a2)) + sq(cross0(a1, a2))),
+                    K(zz[i] * zz[j]));
+            }
+            else
+            {
+                out[k] = (sq(cross1(a1, a2)) + sq(cross0(a1, a2))) /
+                    (zz[i] * zz[j]);
+            }
+        }
+    });
 }
 
 template <typename... Args>
@@ -168,4 +239,50 @@ inline constexpr auto angle(const L& l, const L& m)
     return std::asin(std::sqrt(double(spread(l, m))));
 }
 
+/*!
+ * @brief Distances between the points a[i] and b[i], in parallel
+ *
+ * @param[in] a
+ * @param[in] b of the same size as a
+ * @param[out] out of the same size as a
+ */
+template <Projective_plane_coord2 P>
+void distance_all(
+    std::span<const P> a, std::span<const P> b, std::span<double> out)
+{
+    assert(b.size() == a.size() && out.size() == a.size());
+    parallel_for(
+        a.size(),
+        [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                out[i] = distance(a[i], b[i]);
+            }
+        },
+        64);
+}
+
+/*!
+ * @brief Angles between the lines l[i] and m[i], in parallel
+ *
+ * @param[in] l
+ * @param[in] m of the same size as l
+ * @param[out] out of the same size as l
+ */
+template <Projective_plane_coord2 L>
+void angle_all(
+    std::span<const L> l, std::span<const L> m, std::span<double> out)
+{
+    assert(m.size() == l.size() && out.size() == l.size());
+    parallel_for(
+        l.size(),
+        [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                out[i] = angle(l[i], m[i]);
+            }
+        },
+        64);
+}
+
 } // namespace fun
@@ -0,0 +1,315 @@
+#pragma once
+
+/*! @file include/exact_sqrt.hpp
+ *  This is a C++ Library header.
+ *
+ *  Perfect squares among integers and fractions, e.g. to tell whether a
+ *  quadrance or a spread belongs to a rational distance or angle. Most
+ *  non-squares are rejected by their residues modulo 64, 63, 65 and 11
+ *  (all but about 1 in 120 of them) before any square root is taken.
+ */
+
+#include "common_concepts.h"
+#include "fractions.hpp"
+#include "parallel.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace fun
+{
+
+namespace detail
+{
+    // builtin or big integers (with msb found by ADL), on which % and
+    // << have their integer meaning; other Integral types (e.g. gf_p,
+    // poly) have no integer square root
+    template <typename Z>
+    concept binary_integer = Integral<Z> &&
+        (std::integral<Z> || requires(const Z& n) { msb(n); });
+
+    // finite fields such as gf_p and gf_pk
+    template <typename F>
+    concept finite_field = requires(const F& a)
+    {
+        { F::order() } -> std::convertible_to<std::uint64_t>;
+        { a.pow(std::uint64_t {}) } -> std::same_as<F>;
+    };
+
+    // number of bits of n > 0
+    template <binary_integer Z>
+    constexpr auto bit_length(const Z& n) -> unsigned
+    {
+        if constexpr (std::integral<Z>)
+        {
+            return unsigned(
+                std::bit_width(static_cast<std::make_unsigned_t<Z>>(n)));
+        }
+        else
+        {
+            return unsigned(msb(n)) + 1;
+        }
+    }
+
+    template <unsigned M>
+    constexpr auto square_residues() -> std::array<bool, M>
+    {
+        auto res = std::array<bool, M> {};
+        for (auto i = 0U; i != M; ++i)
+        {
+            res[i * i % M] = true;
+        }
+        return res;
+    }
+
+    template <unsigned M>
+    inline constexpr auto is_residue = square_residues<M>();
+
+    // false if n >= 0 is certainly not a square
+    template <binary_integer Z>
+    constexpr auto maybe_square(const Z& n) -> bool
+    {
+        if (!is_residue<64>[static_cast<unsigned>(n % Z(64))])
+        {
+            return false;
+        }
+        const auto r = static_cast<unsigned>(n % Z(45045)); // 63 * 65 * 11
+        return is_residue<63>[r % 63] && is_residue<65>[r % 65] &&
+            is_residue<11>[r % 11];
+    }
+} // namespace detail
+
+/*!
+ * @brief Integer square root, floor(sqrt(n)), by Newton iteration
+ *
+ * @tparam Z
+ * @param[in] n non-negative
+ * @return Z
+ */
+template <detail::binary_integer Z>
+constexpr auto isqrt(const Z& n) -> Z
+{
+    if (n < Z(2))
+    {
+        return n;
+    }
+    // start from 2^ceil(bits / 2) >= sqrt(n), then decrease monotonically
+    auto x = Z(Z(1) << ((detail::bit_length(n) + 1) / 2));
+    auto y = Z((x + n / x) / Z(2));
+    while (y < x)
+    {
+        x = y;
+        y = (x + n / x) / Z(2);
+    }
+    return x;
+}
+
+/*!
+ * @brief Exact square root of an integer
+ *
+ * @tparam Z
+ * @param[in] n
+ * @return r with r * r == n, or std::nullopt if n is not a perfect square
+ */
+template <detail::binary_integer Z>
+constexpr auto exact_sqrt(const Z& n) -> std::optional<Z>
+{
+    if (n < Z(0) || !detail::maybe_square(n))
+    {
+        return std::nullopt;
+    }
+    auto r = isqrt(n);
+    if (r * r != n)
+    {
+        return std::nullopt;
+    }
+    return r;
+}
+
+/*!
+ * @brief Whether an integer is a perfect square
+ *
+ * @tparam Z
+ * @param[in] n
+ * @return true if n = r * r for some integer r
+ */
+template <detail::binary_integer Z>
+constexpr auto is_square(const Z& n) -> bool
+{
+    return exact_sqrt(n).has_value();
+}
+
+/*!
+ * @brief Exact square root of a fraction
+ *
+ * @tparam Z
+ * @param[in] q
+ * @return r with r * r == q, or std::nullopt if q is not a rational square
+ */
+template <detail::binary_integer Z>
+constexpr auto exact_sqrt(const Fraction<Z>& q) -> std::optional<Fraction<Z>>
+{
+    // the denominator is not always kept positive by Fraction::normalize
+    const auto neg = q.den() < Z(0);
+    auto n = exact_sqrt(neg ? Z(-q.num()) : q.num());
+    if (!n)
+    {
+        return std::nullopt;
+    }
+    auto d = exact_sqrt(neg ? Z(-q.den()) : q.den());
+    if (!d)
+    {
+        return std::nullopt;
+    }
+    return Fraction<Z>(std::move(*n), std::move(*d));
+}
+
+/*!
+ * @brief Whether a fraction is the square of a fraction
+ *
+ * @tparam Z
+ * @param[in] q
+ * @return true if q = r * r for some fraction r
+ */
+template <detail::binary_integer Z>
+constexpr auto is_square(const Fraction<Z>& q) -> bool
+{
+    // in lowest terms, so both num and den must be squares; the cheap
+    // filters are tried on both before any square root
+    const auto neg = q.den() < Z(0);
+    const auto n = neg ? Z(-q.num()) : q.num();
+    const auto d = neg ? Z(-q.den()) : q.den();
+    if (n < Z(0) || !detail::maybe_square(n) || !detail::maybe_square(d))
+    {
+        return false;
+    }
+    const auto rn = isqrt(n);
+    if (rn * rn != n)
+    {
+        return false;
+    }
+    const auto rd = isqrt(d);
+    return rd * rd == d;
+}
+
+/*!
+ * @brief Square root of a floating point number
+ *
+ * @tparam T
+ * @param[in] x
+ * @return sqrt(x), or std::nullopt if x is negative
+ */
+template <std::floating_point T>
+inline auto exact_sqrt(const T& x) -> std::optional<T>
+{
+    if (x < T(0))
+    {
+        return std::nullopt;
+    }
+    return std::sqrt(x);
+}
+
+/*!
+ * @brief Square root in a finite field (Tonelli-Shanks)
+ *
+ * Over a field of odd order q, a nonzero a is a square iff
+ * a^((q - 1) / 2) == 1 (Euler's criterion); over GF(2^k) every element is
+ * the square of a^(q / 2).
+ *
+ * @tparam F e.g. gf_p or gf_pk
+ * @param[in] a
+ * @return r with r * r == a, or std::nullopt if a is not a square
+ */
+template <detail::finite_field F>
+auto exact_sqrt(const F& a) -> std::optional<F>
+{
+    const auto q = std::uint64_t(F::order());
+    if (q % 2 == 0)
+    {
+        return a.pow(q / 2);
+    }
+    if (a == F(0))
+    {
+        return a;
+    }
+    if (a.pow((q - 1) / 2) != F(1))
+    {
+        return std::nullopt;
+    }
+    // q - 1 = 2^s t with t odd
+    auto s = 0U;
+    auto t = q - 1;
+    for (; t % 2 == 0; t /= 2)
+    {
+        ++s;
+    }
+    // any non-square z, whose powers z^t generate the 2-Sylow subgroup
+    auto z = F::from_index(2);
+    for (auto i = 3U; z.pow((q - 1) / 2) == F(1); ++i)
+    {
+        z = F::from_index(i);
+    }
+    auto c = z.pow(t);
+    auto x = a.pow((t + 1) / 2); // x^2 == a b
+    auto b = a.pow(t);
+    auto m = s;
+    while (b != F(1))
+    {
+        // least i with b^(2^i) == 1, then i < m
+        auto i = 0U;
+        for (auto b2 = b; b2 != F(1); b2 *= b2)
+        {
+            ++i;
+        }
+        auto g = c;
+        for (auto k = i + 1; k < m; ++k)
+        {
+            g *= g;
+        }
+        x *= g;
+        c = g * g;
+        b *= c;
+        m = i;
+    }
+    return x;
+}
+
+/*!
+ * @brief Indices of the perfect squares in a batch, found in parallel
+ *
+ * @tparam T integer or Fraction
+ * @param[in] vals
+ * @return indices i, in increasing order, such that is_square(vals[i])
+ */
+template <typename T>
+auto select_squares(std::span<const T> vals) -> std::vector<std::size_t>
+{
+    auto flag = std::vector<char>(vals.size());
+    parallel_for(
+        vals.size(),
+        [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                flag[i] = is_square(vals[i]) ? 1 : 0;
+            }
+        },
+        256);
+    auto res = std::vector<std::size_t> {};
+    for (auto i = 0U; i != flag.size(); ++i)
+    {
+        if (flag[i] != 0)
+        {
+            res.push_back(i);
+        }
+    }
+    return res;
+}
+
+} // namespace fun
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <boost/container/small_vector.hpp>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <utility>
+
+/*! @file include/expansion.hpp
+ *  This is a C++ Library header.
+ *
+ *  Exact floating point arithmetic by expansions (J. R. Shewchuk, Adaptive
+ *  Precision Floating-Point Arithmetic and Fast Robust Geometric
+ *  Predicates, 1997): a number is kept as an unevaluated sum of doubles
+ *  of increasing magnitude whose significands do not overlap. Sums,
+ *  differences and products of expansions are exact, provided that no
+ *  intermediate result overflows or underflows.
+ */
+
+namespace fun
+{
+
+namespace detail
+{
+    // a + b = x + y exactly, with x = fl(a + b)
+    inline auto two_sum(double a, double b) -> std::pair<double, double>
+    {
+        const auto x = a + b;
+        const auto bv = x - a;
+        const auto av = x - bv;
+        return {x, (a - av) + (b - bv)};
+    }
+
+    // a * b = x + y exactly, with x = fl(a * b)
+    inline auto two_prod(double a, double b) -> std::pair<double, double>
+    {
+        const auto x = a * b;
+        return {x, std::fma(a, b, -x)};
+    }
+} // namespace detail
+
+/**
+ * @brief Exact sum of non-overlapping doubles
+ *
+ * Sums and products are compressed as they are formed, and up to 16
+ * components are stored inline. For points given in double, a join has
+ * up to 4 components per coordinate, and a meet of two joins up to 8.
+ * Those meets, and most of the incidence tests on them, run without heap
+ * allocation. Comparisons use the sign of the difference, so expansion
+ * is an ordered_ring; it has no division.
+ */
+class expansion
+{
+    using storage = boost::container::small_vector<double, 16>;
+
+    storage _comp; // increasing magnitude, no zeros
+
+    // h = e + f (fast_expansion_sum_zeroelim), merging e and f by
+    // increasing magnitude on the fly
+    static void sum(const storage& e, const storage& f, storage& h)
+    {
+        h.clear();
+        if (e.empty() || f.empty())
+        {
+            h = e.empty() ? f : e;
+            return;
+        }
+        auto i = std::size_t(0);
+        auto j = std::size_t(0);
+        const auto next = [&]() {
+            if (j == f.size() ||
+                (i != e.size() && std::abs(e[i]) < std::abs(f[j])))
+            {
+                return e[i++];
+            }
+            return f[j++];
+        };
+        auto q = next();
+        while (i != e.size() || j != f.size())
+        {
+            auto [x, y] = detail::two_sum(q, next());
+            if (y != 0.)
+            {
+                h.push_back(y);
+            }
+            q = x;
+        }
+        if (q != 0.)
+        {
+            h.push_back(q);
+        }
+    }
+
+    // h = e * b (scale_expansion_zeroelim)
+    static void scale(const storage& e, double b, storage& h)
+    {
+        h.clear();
+        if (e.empty() || b == 0.)
+        {
+            return;
+        }
+        auto [q, lo] = detail::two_prod(e[0], b);
+        if (lo != 0.)
+        {
+            h.push_back(lo);
+        }
+        for (auto k = std::size_t(1); k != e.size(); ++k)
+        {
+            const auto [p1, p0] = detail::two_prod(e[k], b);
+            const auto [s1, s0] = detail::two_sum(q, p0);
+            if (s0 != 0.)
+            {
+                h.push_back(s0);
+            }
+            const auto [t1, t0] = detail::two_sum(p1, s1);
+            if (t0 != 0.)
+            {
+                h.push_back(t0);
+            }
+            q = t1;
+        }
+        if (q != 0.)
+        {
+            h.push_back(q);
+        }
+    }
+
+    // fewer, larger components (compress), in place
+    static void compress(storage& e)
+    {
+        if (e.size() < 2)
+        {
+            return;
+        }
+        // top-down: the components kept are written above the one read
+        auto bottom = e.size() - 1;
+        auto q = e.back();
+        for (auto k = e.size() - 1; k-- != 0;)
+        {
+            const auto [x, y] = detail::two_sum(q, e[k]);
+            if (y != 0.)
+            {
+                e[bottom--] = x;
+                q = y;
+            }
+            else
+            {
+                q = x;
+            }
+        }
+        e[bottom] = q;
+        // bottom-up: the components kept are written below the one read
+        auto top = std::size_t(0);
+        for (auto k = bottom + 1; k != e.size(); ++k)
+        {
+            const auto [x, y] = detail::two_sum(e[k], q);
+            if (y != 0.)
+            {
+                e[top++] = y;
+            }
+            q = x;
+        }
+        if (q != 0.)
+        {
+            e[top++] = q;
+        }
+        e.resize(top);
+    }
+
+  public:
+    /*!
+     * @brief Construct zero
+     *
+     */
+    expansion() = default;
+
+    /*!
+     * @brief Construct from a double, exactly
+     *
+     * @param[in] a
+     */
+    expansion(double a) // NOLINT(google-explicit-constructor)
+    {
+        if (a != 0.)
+        {
+            this->_comp.push_back(a);
+        }
+    }
+
+    /*!
+     * @brief
+     *
+     * @return components, by increasing magnitude
+     */
+    [[nodiscard]] auto components() const -> const storage&
+    {
+        return this->_comp;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return -1, 0 or 1
+     */
+    [[nodiscard]] auto sign() const -> int
+    {
+        return this->_comp.empty() ? 0 : (this->_comp.back() < 0. ? -1 : 1);
+    }
+
+    /*!
+     * @brief nearest double, up to one rounding of the sum
+     *
+     * @return double
+     */
+    explicit operator double() const
+    {
+        auto s = 0.;
+        for (const auto c : this->_comp)
+        {
+            s += c;
+        }
+        return s;
+    }
+
+    auto operator+=(const expansion& b) -> expansion&
+    {
+        auto res = storage {};
+        sum(this->_comp, b._comp, res);
+        compress(res);
+        this->_comp.swap(res);
+        return *this;
+    }
+
+    auto operator-=(const expansion& b) -> expansion&
+    {
+        return *this += -b;
+    }
+
+    auto operator*=(const expansion& b) -> expansion&
+    {
+        auto res = storage {};
+        auto part = storage {};
+        auto acc = storage {};
+        for (const auto c : b._comp)
+        {
+            scale(this->_comp, c, part);
+            sum(res, part, acc);
+            compress(acc);
+            res.swap(acc);
+        }
+        this->_comp.swap(res);
+        return *this;
+    }
+
+    auto operator-() const -> expansion
+    {
+        auto res = *this;
+        for (auto& c : res._comp)
+        {
+            c = -c;
+        }
+        return res;
+    }
+
+    friend auto operator+(expansion a, const expansion& b) -> expansion
+    {
+        return a += b;
+    }
+
+    friend auto operator-(expansion a, const expansion& b) -> expansion
+    {
+        return a -= b;
+    }
+
+    friend auto operator*(expansion a, const expansion& b) -> expansion
+    {
+        return a *= b;
+    }
+
+    friend auto operator==(const expansion& a, const expansion& b) -> bool
+    {
+        return (a - b).sign() == 0;
+    }
+
+    friend auto operator<=>(const expansion& a, const expansion& b)
+        -> std::strong_ordering
+    {
+        return (a - b).sign() <=> 0;
+    }
+
+    template <typename Stream>
+    friend auto operator<<(Stream& os, const expansion& a) -> Stream&
+    {
+        os << double(a);
+        return os;
+    }
+};
+
+} // namespace fun
@@ -0,0 +1,363 @@
+#pragma once
+
+#include "parallel.hpp"
+#include "pg_line.hpp"
+#include "pg_point.hpp"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <variant>
+#include <vector>
+
+/*! @file include/finite_plane.hpp
+ *  This is a C++ Library header.
+ *
+ *  The finite projective plane PG(2, q) over a field F of order q, e.g.
+ *  gf_p<P>. F must provide order(), from_index(i) and index(), which
+ *  number its elements 0, 1, ..., q - 1.
+ *
+ *  The q^2 + q + 1 points and lines are numbered by their canonical
+ *  coordinates, whose last nonzero one is 1:
+ *
+ *      (x, y, 1) -> x + q y,  (x, 1, 0) -> q^2 + x,  (1, 0, 0) -> q^2 + q
+ *
+ *  Point i is incident with line j exactly when line i is incident with
+ *  point j, so the incidence matrix is symmetric.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Enumerator of the points and lines of PG(2, q)
+ *
+ * @tparam F finite field
+ */
+template <typename F>
+class finite_plane
+{
+    std::size_t _q;
+
+    // the field of order q on the current thread until the end of the
+    // scope, for run-time fields such as gf_p<>
+    static auto field_scope([[maybe_unused]] std::size_t q)
+    {
+        if constexpr (requires { F::set_modulus(std::uint32_t(q)); })
+        {
+            return typename F::scoped_modulus {std::uint32_t(q)};
+        }
+        else
+        {
+            return std::monostate {};
+        }
+    }
+
+    auto coords(std::size_t i) const -> std::array<F, 3>
+    {
+        const auto q = this->_q;
+        if (i < q * q)
+        {
+            return {F::from_index(i % q), F::from_index(i / q), F(1)};
+        }
+        if (i < q * q + q)
+        {
+            return {F::from_index(i - q * q), F(1), F(0)};
+        }
+        return {F(1), F(0), F(0)};
+    }
+
+  public:
+    using point_type = pg_point<F>;
+    using line_type = pg_line<F>;
+
+    /*!
+     * @brief PG(2, F::order())
+     *
+     */
+    finite_plane()
+        : _q {std::size_t(F::order())}
+    {
+    }
+
+    /*!
+     * @brief the order q of the plane
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] auto order() const -> std::size_t
+    {
+        return this->_q;
+    }
+
+    /*!
+     * @brief number of points, which is also the number of lines
+     *
+     * @return q^2 + q + 1
+     */
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->_q * this->_q + this->_q + 1;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i in [0, size())
+     * @return point_type canonical point i
+     */
+    auto point(std::size_t i) const -> point_type
+    {
+        return point_type {this->coords(i)};
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i in [0, size())
+     * @return line_type canonical line i
+     */
+    auto line(std::size_t i) const -> line_type
+    {
+        return line_type {this->coords(i)};
+    }
+
+    /*!
+     * @brief index of a point or line, in O(1)
+     *
+     * @param[in] v homogeneous coordinates, not all zero
+     * @return std::size_t
+     */
+    auto index(const std::array<F, 3>& v) const -> std::size_t
+    {
+        const auto q = this->_q;
+        if (v[2] != F(0))
+        {
+            const auto inv = F(1) / v[2];
+            return (v[0] * inv).index() + q * (v[1] * inv).index();
+        }
+        if (v[1] != F(0))
+        {
+            return q * q + (v[0] / v[1]).index();
+        }
+        assert(v[0] != F(0));
+        return q * q + q;
+    }
+
+    /*!
+     * @brief indices of the q + 1 points on a line (or lines through a
+     *        point), in O(q) with one or two inversions
+     *
+     * @param[in] l
+     * @param[out] out q + 1 indices
+     */
+    void incident_to(
+        const std::array<F, 3>& l, std::span<std::size_t> out) const
+    {
+        assert(out.size() == this->_q + 1);
+        const auto q = this->_q;
+        const auto& [a, b, c] = l;
+        auto k = std::size_t(0);
+        if (b != F(0))
+        {
+            // (x, y, 1) with y = -(a x + c) / b, and one point at infinity
+            const auto inv = F(0) - F(1) / b;
+            for (auto x = std::size_t(0); x != q; ++x)
+            {
+                const auto y = (a * F::from_index(x) + c) * inv;
+                out[k++] = x + q * y.index();
+            }
+            out[k] = a != F(0) ? q * q + (b * (F(0) - F(1) / a)).index()
+                               : q * q + q;
+        }
+        else if (a != F(0))
+        {
+            // (x, y, 1) with x = -c / a, and (0, 1, 0)
+            const auto x = (c * (F(0) - F(1) / a)).index();
+            for (auto y = std::size_t(0); y != q; ++y)
+            {
+                out[k++] = x + q * y;
+            }
+            out[k] = q * q;
+        }
+        else
+        {
+            // the line at infinity
+            for (auto x = std::size_t(0); x != q; ++x)
+            {
+                out[k++] = q * q + x;
+            }
+            out[k] = q * q + q;
+        }
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] l
+     * @return std::vector<std::size_t> indices of the points on l
+     */
+    auto points_on(const line_type& l) const -> std::vector<std::size_t>
+    {
+        auto out = std::vector<std::size_t>(this->_q + 1);
+        this->incident_to(l, out);
+        return out;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] p
+     * @return std::vector<std::size_t> indices of the lines through p
+     */
+    auto lines_through(const point_type& p) const -> std::vector<std::size_t>
+    {
+        auto out = std::vector<std::size_t>(this->_q + 1);
+        this->incident_to(p, out);
+        return out;
+    }
+
+    /*!
+     * @brief Call fn(j, points) for every line j, in parallel, where points
+     *        are the indices of the q + 1 points on line j
+     *
+     * Needs O(q) memory per thread only, so it is usable for q in the
+     * thousands, where the incidence matrix is not.
+     *
+     * @param[in] fn callable (std::size_t, std::span<const std::size_t>)
+     */
+    template <typename Fn>
+    void for_each_line(const Fn& fn) const
+    {
+        const auto q = this->_q;
+        parallel_for_scratch(
+            this->size(),
+            [q] { return std::vector<std::size_t>(q + 1); },
+            [&](std::vector<std::size_t>& pts, std::size_t first,
+                std::size_t last) {
+                [[maybe_unused]] const auto field = field_scope(q);
+                for (auto j = first; j != last; ++j)
+                {
+                    this->incident_to(this->coords(j), pts);
+                    fn(j, std::span<const std::size_t>(pts));
+                }
+            },
+            64);
+    }
+};
+
+/**
+ * @brief Point-line incidence matrix of PG(2, q) as packed bitsets
+ *
+ * Row i holds the lines through point i, which (by symmetry) are also the
+ * points on line i. It takes (q^2 + q + 1)^2 / 8 bytes, about 33 MB for
+ * q = 127 and 138 GB for q = 1024.
+ */
+class incidence_matrix
+{
+    std::size_t _n;
+    std::size_t _words; // per row
+    std::vector<std::uint64_t> _bits;
+
+  public:
+    /*!
+     * @brief Build the matrix of a plane, one row per task
+     *
+     * @tparam F
+     * @param[in] plane
+     */
+    template <typename F>
+    explicit incidence_matrix(const finite_plane<F>& plane)
+        : _n {plane.size()}
+        , _words {(_n + 63) / 64}
+        , _bits(_n * _words)
+    {
+        // row j is written only by the task of line j
+        plane.for_each_line(
+            [this](std::size_t j, std::span<const std::size_t> pts) {
+                auto* row = this->_bits.data() + j * this->_words;
+                for (const auto i : pts)
+                {
+                    row[i / 64] |= std::uint64_t(1) << (i % 64);
+                }
+            });
+    }
+
+    /*!
+     * @brief number of rows (and columns)
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->_n;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i
+     * @return std::span<const std::uint64_t> packed row i
+     */
+    [[nodiscard]] auto row(std::size_t i) const
+        -> std::span<const std::uint64_t>
+    {
+        return {this->_bits.data() + i * this->_words, this->_words};
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i point
+     * @param[in] j line
+     * @return whether point i lies on line j
+     */
+    [[nodiscard]] auto incident(std::size_t i, std::size_t j) const -> bool
+    {
+        return ((this->row(i)[j / 64] >> (j % 64)) & 1U) != 0;
+    }
+
+    /*!
+     * @brief Number of lines through all the given points (or of points on
+     *        all the given lines)
+     *
+     * @param[in] rows
+     * @return std::size_t
+     */
+    [[nodiscard]] auto common(std::span<const std::size_t> rows) const
+        -> std::size_t
+    {
+        if (rows.empty())
+        {
+            return this->_n; // not to count the padding of the last word
+        }
+        auto count = std::size_t(0);
+        for (auto w = std::size_t(0); w != this->_words; ++w)
+        {
+            auto word = ~std::uint64_t(0);
+            for (const auto i : rows)
+            {
+                word &= this->row(i)[w];
+            }
+            count += std::size_t(std::popcount(word));
+        }
+        return count;
+    }
+
+    /*!
+     * @brief Whether distinct points are collinear (or distinct lines are
+     *        concurrent)
+     *
+     * @param[in] rows
+     * @return bool
+     */
+    [[nodiscard]] auto collinear(std::span<const std::size_t> rows) const
+        -> bool
+    {
+        return this->common(rows) != 0;
+    }
+};
+
+} // namespace fun
@@ -6,8 +6,12 @@
  */
 
 #include <boost/operators.hpp>
-// #include <cmath>
 #include "common_concepts.h"
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
 #include <numeric>
 #include <type_traits>
 #include <utility>
@@ -97,6 +101,93 @@ inline constexpr auto lcm(_Mn __m, _Mn __n) -> _Mn
 }
 
 
+namespace detail
+{
+    // n / d = (q + f) 2^-s with q in [2^54, 2^55) and 0 <= f < 1;
+    // sticky tells whether f != 0
+    struct frac_bits
+    {
+        std::uint64_t q;
+        int s;
+        bool sticky;
+    };
+
+    // restoring division, for n, d > 0
+    inline auto to_frac_bits(std::uint64_t n, std::uint64_t d) -> frac_bits
+    {
+        auto e = int(std::bit_width(n)) - int(std::bit_width(d));
+        // align d with n, so that d <= r < 2 d; r has an implicit bit 64
+        auto r = e >= 0 ? n : n << unsigned(-e);
+        const auto den = e >= 0 ? d << unsigned(e) : d;
+        auto hi = false;
+        if (r < den)
+        {
+            hi = (r >> 63U) != 0;
+            r <<= 1U;
+            --e;
+        }
+        auto q = std::uint64_t(0);
+        for (auto k = 0; k != 55; ++k)
+        {
+            q <<= 1U;
+            if (hi || r >= den)
+            {
+                q |= 1U;
+                r -= den;
+            }
+            hi = (r >> 63U) != 0;
+            r <<= 1U;
+        }
+        return {q, 54 - e, hi || r != 0};
+    }
+
+    // big integers with shifts and msb (found by ADL), for n, d > 0
+    template <typename Z>
+    auto to_frac_bits(const Z& n, const Z& d) -> frac_bits
+    {
+        auto s = 54 - (int(msb(n)) - int(msb(d)));
+        const auto num = s >= 0 ? Z(n << unsigned(s)) : n;
+        const auto den = s >= 0 ? d : Z(d << unsigned(-s));
+        auto q = Z(num / den);
+        auto r = Z(num - q * den);
+        if (q < (Z(1) << 54U))
+        {
+            q <<= 1U;
+            r <<= 1U;
+            if (r >= den)
+            {
+                q += 1;
+                r -= den;
+            }
+            ++s;
+        }
+        return {static_cast<std::uint64_t>(q), s, r != 0};
+    }
+
+    // (q + f) 2^-s rounded to nearest, ties to even
+    inline auto round_frac_bits(frac_bits b) -> double
+    {
+        // below 2^-1022, keep the bits down to 2^-1076 only
+        if (b.s > 1076)
+        {
+            const auto k = unsigned(b.s - 1076);
+            const auto dropped = k >= 64 ? b.q : b.q & ((1ULL << k) - 1);
+            b.sticky = b.sticky || dropped != 0;
+            b.q = k >= 64 ? 0 : b.q >> k;
+            b.s = 1076;
+        }
+        // two bits below the 53 kept: the rounding bit and a sticky bit
+        auto m = b.q >> 2U;
+        const auto half = (b.q & 2U) != 0;
+        const auto rest = (b.q & 1U) != 0 || b.sticky;
+        if (half && (rest || (m & 1U) != 0))
+        {
+            ++m;
+        }
+        return std::ldexp(double(m), 2 - b.s);
+    }
+} // namespace detail
+
 template <Integral Z>
 struct Fraction : boost::totally_ordered<Fraction<Z>,
                       boost::totally_ordered2<Fraction<Z>, Z,
@@ -500,15 +591,55 @@ struct Fraction : boost::totally_ordered<Fraction<Z>,
         return this->_num > this->_den * rhs;
     }
 
-    // /*!
-    //  * @brief
-    //  *
-    //  * @return double
-    //  */
-    // constexpr explicit operator double())
-    // {
-    //     return double(_num) / _den;
-    // }
+    /*!
+     * @brief Nearest double (ties to even)
+     *
+     * When both num and den have at most 53 bits they are exact as
+     * doubles and a single division is correctly rounded. Otherwise 55
+     * bits of the quotient are formed by shifting, with the remainder kept
+     * as a sticky bit, and rounded once.
+     *
+     * @return double
+     */
+    explicit operator double() const
+    {
+        if (this->_den == Z(0)) // as 1. / 0. etc.
+        {
+            constexpr auto inf = std::numeric_limits<double>::infinity();
+            if (this->_num == Z(0))
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return this->_num > Z(0) ? inf : -inf;
+        }
+        if (this->_num == Z(0))
+        {
+            return 0.;
+        }
+        const auto neg = (this->_num < Z(0)) != (this->_den < Z(0));
+        auto res = 0.;
+        if constexpr (std::integral<Z>)
+        {
+            const auto mag = [](Z a) {
+                const auto u = static_cast<std::uint64_t>(a);
+                return a < Z(0) ? 0 - u : u;
+            };
+            const auto n = mag(this->_num);
+            const auto d = mag(this->_den);
+            res = (n >> 53U) == 0 && (d >> 53U) == 0
+                ? double(n) / double(d)
+                : detail::round_frac_bits(detail::to_frac_bits(n, d));
+        }
+        else
+        {
+            const auto n = fun::abs(this->_num);
+            const auto d = fun::abs(this->_den);
+            res = msb(n) < 53 && msb(d) < 53
+                ? static_cast<double>(n) / static_cast<double>(d)
+                : detail::round_frac_bits(detail::to_frac_bits(n, d));
+        }
+        return neg ? -res : res;
+    }
 
     // /**
     //  * @brief
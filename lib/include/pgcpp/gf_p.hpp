@@ -0,0 +1,382 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*! @file include/gf_p.hpp
+ *  This is a C++ Library header.
+ */
+
+namespace fun
+{
+
+/*!
+ * @brief Whether n is prime (trial division)
+ *
+ * @param[in] n
+ * @return true
+ * @return false
+ */
+constexpr auto is_prime_u32(std::uint32_t n) -> bool
+{
+    if (n < 2)
+    {
+        return false;
+    }
+    for (auto d = std::uint32_t(2); std::uint64_t(d) * d <= n; ++d)
+    {
+        if (n % d == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Constants of Montgomery multiplication modulo an odd p < 2^31,
+ *        with R = 2^32
+ *
+ */
+struct montgomery_params
+{
+    std::uint32_t mod; //!< p
+    std::uint32_t neg_inv; //!< -p^-1 mod R
+    std::uint32_t r2; //!< R^2 mod p
+
+    /*!
+     * @brief Construct a new montgomery params object
+     *
+     * @param[in] p odd, less than 2^31
+     */
+    constexpr explicit montgomery_params(std::uint32_t p)
+        : mod {p}
+        , neg_inv {0}
+        , r2 {0}
+    {
+        auto x = p; // p * x == 1 mod 2^k, k doubling every step
+        for (auto i = 0; i != 5; ++i)
+        {
+            x *= 2U - p * x;
+        }
+        this->neg_inv = 0U - x;
+        const auto r = (std::uint64_t(1) << 32U) % p;
+        this->r2 = std::uint32_t(r * r % p);
+    }
+
+    /*!
+     * @brief Montgomery reduction, t R^-1 mod p
+     *
+     * @param[in] t less than p R
+     * @return std::uint32_t in [0, p)
+     */
+    [[nodiscard]] constexpr auto reduce(std::uint64_t t) const
+        -> std::uint32_t
+    {
+        const auto m = std::uint32_t(t) * this->neg_inv;
+        const auto u =
+            std::uint32_t((t + std::uint64_t(m) * this->mod) >> 32U);
+        return u >= this->mod ? u - this->mod : u;
+    }
+};
+
+/**
+ * @brief Element of the prime field GF(p), in Montgomery form
+ *
+ * With P != 0 the prime is fixed at compile time. With P == 0 it is set at
+ * run time by set_modulus(), separately for each thread.
+ *
+ * Besides the field operations, gf_p provides what the Integral concept
+ * asks of an integer type, so that pg_point<gf_p<P>>, ellck, hyck,
+ * involution etc. can be instantiated: division multiplies by the inverse,
+ * a % b is 0 (the remainder of exact division), and the ordering is that
+ * of the canonical values in [0, p). The ordering is not compatible with
+ * the field operations.
+ *
+ * The run-time prime is thread_local and is 3 on every new thread,
+ * including the threads of default_pool(). So a task run by parallel_for
+ * etc. on gf_p<> values must set the prime itself, preferably with a
+ * scoped_modulus, which also restores the prime of the calling thread.
+ *
+ * @tparam P odd prime less than 2^31, or 0 for a run-time prime
+ */
+template <std::uint32_t P = 0>
+class gf_p
+{
+    static_assert(P == 0 || (P > 2 && P < (1U << 31U) && is_prime_u32(P)),
+        "P must be an odd prime less than 2^31");
+
+    static constexpr auto _ct = montgomery_params {P == 0 ? 3U : P};
+    static inline thread_local montgomery_params _rt {3U};
+
+    std::uint32_t _v {0}; // value * R mod p
+
+    static constexpr auto params() -> const montgomery_params&
+    {
+        if constexpr (P == 0)
+        {
+            return _rt;
+        }
+        else
+        {
+            return _ct;
+        }
+    }
+
+    struct raw_t
+    {
+    };
+
+    constexpr gf_p(std::uint32_t v, raw_t /* unused */)
+        : _v {v}
+    {
+    }
+
+  public:
+    /*!
+     * @brief Set the prime of gf_p<0> for the calling thread
+     *
+     * @param[in] p odd prime less than 2^31
+     */
+    static void set_modulus(std::uint32_t p)
+        requires(P == 0)
+    {
+        assert(p > 2 && p < (1U << 31U) && is_prime_u32(p));
+        _rt = montgomery_params {p};
+    }
+
+    /**
+     * @brief Sets the prime of gf_p<0> for the calling thread until the end
+     *        of the scope, then restores the previous one
+     *
+     */
+    class scoped_modulus
+    {
+        montgomery_params _saved;
+
+      public:
+        /*!
+         * @brief Construct a new scoped modulus object
+         *
+         * @param[in] p odd prime less than 2^31
+         */
+        explicit scoped_modulus(std::uint32_t p)
+            : _saved {_rt}
+        {
+            set_modulus(p);
+        }
+
+        scoped_modulus(const scoped_modulus&) = delete;
+        auto operator=(const scoped_modulus&) -> scoped_modulus& = delete;
+
+        /*!
+         * @brief Destroy the scoped modulus object, restoring the prime
+         *
+         */
+        ~scoped_modulus()
+        {
+            _rt = this->_saved;
+        }
+    };
+
+    /*!
+     * @brief the prime p
+     *
+     * @return std::uint32_t
+     */
+    static constexpr auto modulus() -> std::uint32_t
+    {
+        return params().mod;
+    }
+
+    /*!
+     * @brief number of elements of the field, i.e. p
+     *
+     * @return std::uint32_t
+     */
+    static constexpr auto order() -> std::uint32_t
+    {
+        return params().mod;
+    }
+
+    /*!
+     * @brief Construct zero
+     *
+     */
+    constexpr gf_p() = default;
+
+    /*!
+     * @brief Construct the residue of an integer
+     *
+     * @param[in] n
+     */
+    template <std::integral T>
+    constexpr gf_p(T n) // NOLINT(google-explicit-constructor)
+    {
+        const auto& pr = params();
+        auto r = std::uint32_t {};
+        if constexpr (std::is_signed_v<T>)
+        {
+            const auto m = std::int64_t(n) % std::int64_t(pr.mod);
+            r = std::uint32_t(m < 0 ? m + pr.mod : m);
+        }
+        else
+        {
+            r = std::uint32_t(std::uint64_t(n) % pr.mod);
+        }
+        this->_v = pr.reduce(std::uint64_t(r) * pr.r2);
+    }
+
+    /*!
+     * @brief element with canonical value i, see index()
+     *
+     * @param[in] i in [0, p)
+     * @return gf_p
+     */
+    static constexpr auto from_index(std::uint32_t i) -> gf_p
+    {
+        return gf_p(i);
+    }
+
+    /*!
+     * @brief canonical value in [0, p)
+     *
+     * @return std::uint32_t
+     */
+    [[nodiscard]] constexpr auto value() const -> std::uint32_t
+    {
+        return params().reduce(this->_v);
+    }
+
+    /*!
+     * @brief canonical value, for indexing tables of size order()
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] constexpr auto index() const -> std::size_t
+    {
+        return this->value();
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] e
+     * @return this^e
+     */
+    [[nodiscard]] constexpr auto pow(std::uint64_t e) const -> gf_p
+    {
+        auto res = gf_p(1);
+        auto b = *this;
+        for (; e != 0; e >>= 1U)
+        {
+            if ((e & 1U) != 0)
+            {
+                res *= b;
+            }
+            b *= b;
+        }
+        return res;
+    }
+
+    /*!
+     * @brief multiplicative inverse (Fermat)
+     *
+     * @return gf_p
+     */
+    [[nodiscard]] constexpr auto inv() const -> gf_p
+    {
+        assert(this->_v != 0);
+        return this->pow(modulus() - 2U);
+    }
+
+    constexpr auto operator+=(const gf_p& b) -> gf_p&
+    {
+        const auto mod = modulus();
+        this->_v += b._v; // both < 2^31, no overflow
+        if (this->_v >= mod)
+        {
+            this->_v -= mod;
+        }
+        return *this;
+    }
+
+    constexpr auto operator-=(const gf_p& b) -> gf_p&
+    {
+        this->_v = this->_v >= b._v ? this->_v - b._v
+                                    : this->_v + modulus() - b._v;
+        return *this;
+    }
+
+    constexpr auto operator*=(const gf_p& b) -> gf_p&
+    {
+        this->_v = params().reduce(std::uint64_t(this->_v) * b._v);
+        return *this;
+    }
+
+    constexpr auto operator/=(const gf_p& b) -> gf_p&
+    {
+        return *this *= b.inv();
+    }
+
+    constexpr auto operator%=(const gf_p& b) -> gf_p&
+    {
+        assert(b._v != 0);
+        this->_v = 0;
+        return *this;
+    }
+
+    constexpr auto operator-() const -> gf_p
+    {
+        return gf_p(this->_v == 0 ? 0U : modulus() - this->_v, raw_t {});
+    }
+
+    friend constexpr auto operator+(gf_p a, const gf_p& b) -> gf_p
+    {
+        return a += b;
+    }
+
+    friend constexpr auto operator-(gf_p a, const gf_p& b) -> gf_p
+    {
+        return a -= b;
+    }
+
+    friend constexpr auto operator*(gf_p a, const gf_p& b) -> gf_p
+    {
+        return a *= b;
+    }
+
+    friend constexpr auto operator/(gf_p a, const gf_p& b) -> gf_p
+    {
+        return a /= b;
+    }
+
+    friend constexpr auto operator%(gf_p a, const gf_p& b) -> gf_p
+    {
+        return a %= b;
+    }
+
+    friend constexpr auto operator==(const gf_p& a, const gf_p& b) -> bool
+    {
+        return a._v == b._v; // Montgomery form is a bijection
+    }
+
+    friend constexpr auto operator<=>(const gf_p& a, const gf_p& b)
+        -> std::strong_ordering
+    {
+        return a.value() <=> b.value();
+    }
+
+    template <typename Stream>
+    friend auto operator<<(Stream& os, const gf_p& a) -> Stream&
+    {
+        os << a.value();
+        return os;
+    }
+};
+
+} // namespace fun
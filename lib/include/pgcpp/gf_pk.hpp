@@ -0,0 +1,440 @@
+#pragma once
+
+#include "gf_p.hpp"
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*! @file include/gf_pk.hpp
+ *  This is a C++ Library header.
+ *
+ *  Extension fields GF(p^k). An element is a polynomial of degree less
+ *  than k over GF(p), stored as the integer whose base-p digits are its
+ *  coefficients (so for k = 1 it is the residue itself). The defining
+ *  polynomial is found by search the first time the field is used.
+ *
+ *  For q = p^k up to 2^16, multiplication and inversion use log/antilog
+ *  tables of a primitive polynomial. For larger GF(2^k) they use
+ *  carry-less multiplication modulo an irreducible polynomial.
+ */
+
+namespace fun
+{
+
+namespace detail
+{
+    // p^k, or 0 if it does not fit in 32 bits
+    constexpr auto gf_order(std::uint32_t p, std::uint32_t k) -> std::uint64_t
+    {
+        auto q = std::uint64_t(1);
+        for (auto i = 0U; i != k; ++i)
+        {
+            q *= p;
+            if (q > 0xFFFFFFFFULL)
+            {
+                return 0;
+            }
+        }
+        return q;
+    }
+
+    // product of polynomials over GF(2) of degree less than 32
+    constexpr auto clmul(std::uint64_t a, std::uint64_t b) -> std::uint64_t
+    {
+        auto r = std::uint64_t(0);
+        for (; b != 0; b >>= 1U, a <<= 1U)
+        {
+            if ((b & 1U) != 0)
+            {
+                r ^= a;
+            }
+        }
+        return r;
+    }
+
+    // t mod f over GF(2), where f = x^k + low
+    constexpr auto clmod(std::uint64_t t, std::uint64_t low, std::uint32_t k)
+        -> std::uint64_t
+    {
+        const auto f = (std::uint64_t(1) << k) | low;
+        for (auto bit = 63U; bit >= k; --bit)
+        {
+            if (((t >> bit) & 1U) != 0)
+            {
+                t ^= f << (bit - k);
+            }
+        }
+        return t;
+    }
+
+    constexpr auto clgcd(std::uint64_t a, std::uint64_t b) -> std::uint64_t
+    {
+        const auto deg = [](std::uint64_t x) { return std::bit_width(x) - 1; };
+        while (b != 0)
+        {
+            while (a != 0 && deg(a) >= deg(b))
+            {
+                a ^= b << (deg(a) - deg(b));
+            }
+            std::swap(a, b);
+        }
+        return a;
+    }
+
+    // Ben-Or: x^k + low is irreducible over GF(2) iff
+    // gcd(f, x^(2^i) - x) = 1 for i = 1, ..., k / 2
+    constexpr auto gf2_irreducible(std::uint64_t low, std::uint32_t k) -> bool
+    {
+        const auto f = (std::uint64_t(1) << k) | low;
+        auto x = std::uint64_t(2);
+        for (auto i = 1U; i <= k / 2; ++i)
+        {
+            x = clmod(clmul(x, x), low, k);
+            if (clgcd(f, x ^ 2U) != 1)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace detail
+
+/**
+ * @brief Element of the finite field GF(p^k)
+ *
+ * Like gf_p, it also provides what the Integral concept asks of an
+ * integer type: division multiplies by the inverse, a % b is 0, and the
+ * ordering is that of index().
+ *
+ * @tparam P prime
+ * @tparam K degree of the extension
+ */
+template <std::uint32_t P, std::uint32_t K>
+class gf_pk
+{
+    static constexpr auto Q = detail::gf_order(P, K);
+    static constexpr auto use_tables = Q <= (1U << 16U);
+
+    static_assert(is_prime_u32(P) && K >= 1, "P must be a prime");
+    static_assert(Q != 0 && (use_tables || P == 2),
+        "p^k must be at most 2^16, or less than 2^32 for p = 2");
+
+    struct tables_t
+    {
+        std::uint32_t poly {0}; // x^k = -poly, coefficients as digits
+        std::vector<std::uint32_t> exp; // g^i, for i in [0, 2 (q - 1))
+        std::vector<std::uint32_t> log; // log_g(a), for a in [1, q)
+    };
+
+    std::uint32_t _v {0};
+
+    // digit-wise a + s b
+    static constexpr auto add(std::uint32_t a, std::uint32_t b,
+        std::uint32_t s = 1) -> std::uint32_t
+    {
+        if constexpr (P == 2)
+        {
+            return a ^ (s * b);
+        }
+        else
+        {
+            auto r = std::uint32_t(0);
+            for (auto w = std::uint32_t(1); a != 0 || b != 0; w *= P)
+            {
+                r += (a % P + s * (b % P)) % P * w;
+                a /= P;
+                b /= P;
+            }
+            return r;
+        }
+    }
+
+    // a x mod poly
+    static constexpr auto times_x(std::uint32_t a, std::uint32_t poly)
+        -> std::uint32_t
+    {
+        const auto top = std::uint32_t(a / (Q / P));
+        const auto shifted = std::uint32_t(a % (Q / P) * P);
+        return add(shifted, poly, (P - top) % P);
+    }
+
+    // the first primitive polynomial, with its log/antilog tables
+    static auto build_tables() -> tables_t
+    {
+        auto t = tables_t {};
+        t.exp.resize(2 * (Q - 1));
+        t.log.resize(Q);
+        for (auto poly = std::uint32_t(1); poly != Q; ++poly)
+        {
+            auto a = std::uint32_t(1);
+            auto i = std::uint32_t(0);
+            do
+            {
+                t.exp[i++] = a;
+                a = times_x(a, poly);
+            } while (a != 1 && i != Q - 1);
+            if (a == 1 && i == Q - 1)
+            {
+                t.poly = poly;
+                break;
+            }
+        }
+        assert(t.poly != 0);
+        for (auto i = std::uint32_t(0); i != Q - 1; ++i)
+        {
+            t.exp[i + Q - 1] = t.exp[i];
+            t.log[t.exp[i]] = i;
+        }
+        return t;
+    }
+
+    static auto tables() -> const tables_t&
+    {
+        static const auto t = build_tables();
+        return t;
+    }
+
+    // the first irreducible x^k + low over GF(2)
+    static auto gf2_poly() -> std::uint32_t
+    {
+        static const auto low = [] {
+            auto l = std::uint64_t(1);
+            while (!detail::gf2_irreducible(l, K))
+            {
+                l += 2;
+            }
+            return std::uint32_t(l);
+        }();
+        return low;
+    }
+
+    struct raw_t
+    {
+    };
+
+    constexpr gf_pk(std::uint32_t v, raw_t /* unused */)
+        : _v {v}
+    {
+    }
+
+  public:
+    /*!
+     * @brief the characteristic p
+     *
+     * @return std::uint32_t
+     */
+    static constexpr auto characteristic() -> std::uint32_t
+    {
+        return P;
+    }
+
+    /*!
+     * @brief number of elements of the field, i.e. p^k
+     *
+     * @return std::uint32_t
+     */
+    static constexpr auto order() -> std::uint32_t
+    {
+        return std::uint32_t(Q);
+    }
+
+    /*!
+     * @brief the defining polynomial x^k - f(x), as the index of f
+     *
+     * @return std::uint32_t
+     */
+    static auto polynomial() -> std::uint32_t
+    {
+        if constexpr (use_tables)
+        {
+            return add(0, tables().poly, P - 1);
+        }
+        else
+        {
+            return gf2_poly();
+        }
+    }
+
+    /*!
+     * @brief Construct zero
+     *
+     */
+    constexpr gf_pk() = default;
+
+    /*!
+     * @brief Construct the image of an integer in the prime subfield
+     *
+     * @param[in] n
+     */
+    template <std::integral T>
+    constexpr gf_pk(T n) // NOLINT(google-explicit-constructor)
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            const auto m = std::int64_t(n) % std::int64_t(P);
+            this->_v = std::uint32_t(m < 0 ? m + P : m);
+        }
+        else
+        {
+            this->_v = std::uint32_t(std::uint64_t(n) % P);
+        }
+    }
+
+    /*!
+     * @brief element with index i, see index()
+     *
+     * @param[in] i in [0, p^k)
+     * @return gf_pk
+     */
+    static constexpr auto from_index(std::uint32_t i) -> gf_pk
+    {
+        return gf_pk(i, raw_t {});
+    }
+
+    /*!
+     * @brief the coefficients as base-p digits, in [0, p^k)
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] constexpr auto index() const -> std::size_t
+    {
+        return this->_v;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] e
+     * @return this^e
+     */
+    [[nodiscard]] auto pow(std::uint64_t e) const -> gf_pk
+    {
+        auto res = gf_pk(1);
+        auto b = *this;
+        for (; e != 0; e >>= 1U)
+        {
+            if ((e & 1U) != 0)
+            {
+                res *= b;
+            }
+            b *= b;
+        }
+        return res;
+    }
+
+    /*!
+     * @brief multiplicative inverse
+     *
+     * @return gf_pk
+     */
+    [[nodiscard]] auto inv() const -> gf_pk
+    {
+        assert(this->_v != 0);
+        if constexpr (use_tables)
+        {
+            const auto& t = tables();
+            return gf_pk(t.exp[Q - 1 - t.log[this->_v]], raw_t {});
+        }
+        else
+        {
+            return this->pow(Q - 2);
+        }
+    }
+
+    constexpr auto operator+=(const gf_pk& b) -> gf_pk&
+    {
+        this->_v = add(this->_v, b._v);
+        return *this;
+    }
+
+    constexpr auto operator-=(const gf_pk& b) -> gf_pk&
+    {
+        this->_v = add(this->_v, b._v, P - 1);
+        return *this;
+    }
+
+    auto operator*=(const gf_pk& b) -> gf_pk&
+    {
+        if constexpr (use_tables)
+        {
+            if (this->_v != 0 && b._v != 0)
+            {
+                const auto& t = tables();
+                this->_v = t.exp[t.log[this->_v] + t.log[b._v]];
+            }
+            else
+            {
+                this->_v = 0;
+            }
+        }
+        else
+        {
+            this->_v = std::uint32_t(detail::clmod(
+                detail::clmul(this->_v, b._v), gf2_poly(), K));
+        }
+        return *this;
+    }
+
+    auto operator/=(const gf_pk& b) -> gf_pk&
+    {
+        return *this *= b.inv();
+    }
+
+    constexpr auto operator%=(const gf_pk& b) -> gf_pk&
+    {
+        assert(b._v != 0);
+        this->_v = 0;
+        return *this;
+    }
+
+    constexpr auto operator-() const -> gf_pk
+    {
+        return gf_pk(add(0, this->_v, P - 1), raw_t {});
+    }
+
+    friend constexpr auto operator+(gf_pk a, const gf_pk& b) -> gf_pk
+    {
+        return a += b;
+    }
+
+    friend constexpr auto operator-(gf_pk a, const gf_pk& b) -> gf_pk
+    {
+        return a -= b;
+    }
+
+    friend auto operator*(gf_pk a, const gf_pk& b) -> gf_pk
+    {
+        return a *= b;
+    }
+
+    friend auto operator/(gf_pk a, const gf_pk& b) -> gf_pk
+    {
+        return a /= b;
+    }
+
+    friend constexpr auto operator%(gf_pk a, const gf_pk& b) -> gf_pk
+    {
+        return a %= b;
+    }
+
+    friend constexpr auto operator==(const gf_pk& a, const gf_pk& b)
+        -> bool = default;
+
+    friend constexpr auto operator<=>(const gf_pk& a, const gf_pk& b)
+        -> std::strong_ordering = default;
+
+    template <typename Stream>
+    friend auto operator<<(Stream& os, const gf_pk& a) -> Stream&
+    {
+        os << a._v;
+        return os;
+    }
+};
+
+} // namespace fun
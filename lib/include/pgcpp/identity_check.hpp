@@ -0,0 +1,218 @@
+#pragma once
+
+#include "fractions.hpp"
+#include "gf_p.hpp"
+#include "multimodular.hpp"
+#include "parallel.hpp"
+#include "verify.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*! @file include/identity_check.hpp
+ *  This is a C++ Library header.
+ *
+ *  Probabilistic identity testing (Schwartz-Zippel). A construction written
+ *  generically over a ring is evaluated at random points of GF(p) for
+ *  random primes p in [2^30, 2^31). A nonzero polynomial of total degree d
+ *  vanishes at a random point with probability at most d / p, so each
+ *  trial that finds zero multiplies the error bound by d / p < d / 2^30.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Options of check_identity
+ *
+ */
+struct identity_options
+{
+    std::uint64_t seed = 1;
+    std::size_t trials = 8; //!< independent (prime, point) pairs
+    std::size_t max_redraws = 16; //!< redraws of a degenerate point
+};
+
+/**
+ * @brief Point of GF(p)^n at which the construction is not zero
+ *
+ */
+struct identity_counterexample
+{
+    std::size_t trial; //!< regenerated by the same seed
+    std::uint32_t prime;
+    std::vector<std::uint32_t> point; //!< canonical values in [0, p)
+};
+
+/**
+ * @brief Outcome of check_identity
+ *
+ */
+struct identity_report
+{
+    std::size_t trials = 0; //!< trials that found zero
+    std::size_t degenerate = 0; //!< trials without a usable point
+    double log2_error = 0.; //!< log2 of the bound on the error probability
+    std::optional<identity_counterexample> counterexample;
+
+    /*!
+     * @brief whether no counterexample was found
+     *
+     * @return true if the identity holds with error probability at most
+     *         error()
+     * @return false if it certainly does not hold
+     */
+    [[nodiscard]] auto holds() const -> bool
+    {
+        return !this->counterexample.has_value();
+    }
+
+    /*!
+     * @brief bound on the probability that the identity does not hold
+     *        although no counterexample was found
+     *
+     * @return double
+     */
+    [[nodiscard]] auto error() const -> double
+    {
+        return std::exp2(this->log2_error);
+    }
+};
+
+namespace detail
+{
+    // whether a value of the construction is zero; std::nullopt if it is
+    // undefined (a vanishing denominator)
+    template <typename T>
+    auto sz_is_zero(const T& x) -> std::optional<bool>
+    {
+        if constexpr (std::is_same_v<T, gf_p<>>)
+        {
+            return x == gf_p<>(0);
+        }
+        else if constexpr (is_gf_fraction<T>::value)
+        {
+            if (x.den() == gf_p<>(0))
+            {
+                return std::nullopt;
+            }
+            return x.num() == gf_p<>(0);
+        }
+        else
+        {
+            auto zero = true;
+            for (const auto& v : x)
+            {
+                const auto z = sz_is_zero(v);
+                if (!z)
+                {
+                    return std::nullopt;
+                }
+                zero = zero && *z;
+            }
+            return zero;
+        }
+    }
+
+    // random prime in [2^30, 2^31)
+    inline auto sz_prime(verify_rng& rng) -> std::uint32_t
+    {
+        for (;;)
+        {
+            const auto n =
+                std::uint32_t(rng.next() >> 34U) | (1U << 30U) | 1U;
+            if (miller_rabin_u32(n))
+            {
+                return n;
+            }
+        }
+    }
+} // namespace detail
+
+/*!
+ * @brief Check that a construction vanishes identically, by evaluating it
+ *        at random points over large prime fields
+ *
+ * fn is called with a std::span<const gf_p<>> of n_vars coordinates, on a
+ * thread whose gf_p<> modulus is the prime of the trial, and returns a
+ * gf_p<>, a Fraction<gf_p<>> or a range of them (e.g. a pg_point), which
+ * should be zero. Points where a denominator vanishes are redrawn. The
+ * trials run in parallel; trial i only depends on (opt.seed, i).
+ *
+ * @param[in] fn
+ * @param[in] n_vars number of variables
+ * @param[in] degree bound on the total degree of (the numerators of) fn
+ * @param[in] opt
+ * @return identity_report
+ */
+template <typename Fn>
+auto check_identity(const Fn& fn, std::size_t n_vars, std::size_t degree,
+    const identity_options& opt = {}) -> identity_report
+{
+    // 0: zero, 1: nonzero, 2: degenerate
+    auto outcome = std::vector<char>(opt.trials);
+    auto primes = std::vector<std::uint32_t>(opt.trials);
+    auto points = std::vector<std::vector<std::uint32_t>>(opt.trials);
+    parallel_for(
+        opt.trials,
+        [&](std::size_t first, std::size_t last) {
+            auto x = std::vector<gf_p<>>(n_vars);
+            for (auto i = first; i != last; ++i)
+            {
+                auto rng = verify_rng {opt.seed, i};
+                const auto p = detail::sz_prime(rng);
+                const auto field = gf_p<>::scoped_modulus {p};
+                primes[i] = p;
+                outcome[i] = 2;
+                for (auto k = std::size_t(0); k <= opt.max_redraws; ++k)
+                {
+                    for (auto& v : x)
+                    {
+                        v = gf_p<>(rng.next() % p);
+                    }
+                    const auto z = detail::sz_is_zero(
+                        fn(std::span<const gf_p<>>(x)));
+                    if (z)
+                    {
+                        outcome[i] = *z ? 0 : 1;
+                        break;
+                    }
+                }
+                if (outcome[i] == 1)
+                {
+                    for (const auto& v : x)
+                    {
+                        points[i].push_back(v.value());
+                    }
+                }
+            }
+        },
+        1);
+
+    auto rep = identity_report {};
+    for (auto i = std::size_t(0); i != opt.trials; ++i)
+    {
+        if (outcome[i] == 1)
+        {
+            rep.counterexample = identity_counterexample {
+                i, primes[i], std::move(points[i])};
+            return rep;
+        }
+        if (outcome[i] == 2)
+        {
+            ++rep.degenerate;
+            continue;
+        }
+        ++rep.trials;
+        rep.log2_error += std::log2(double(degree) / double(primes[i]));
+    }
+    rep.log2_error = std::min(rep.log2_error, 0.);
+    return rep;
+}
+
+} // namespace fun
@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <boost/logic/tribool.hpp>
+#include <cassert>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <limits>
+
+/*! @file include/interval.hpp
+ *  This is a C++ Library header.
+ *
+ *  Interval arithmetic with outward rounding, for certified floating
+ *  point geometry. The rounding direction of each operation is found from
+ *  its exact error (two_sum, fma), so the enclosures are as tight as
+ *  directed rounding would give, without changing the rounding mode.
+ */
+
+namespace fun
+{
+
+namespace detail
+{
+    // s + e rounded down, where s is the rounded result and e its error
+    template <std::floating_point T>
+    auto round_down(T s, T e) -> T
+    {
+        if (std::isnan(s)) // inf - inf: could be anything
+        {
+            return -std::numeric_limits<T>::infinity();
+        }
+        if (std::isinf(s))
+        {
+            return s > 0 ? std::numeric_limits<T>::max() : s;
+        }
+        return e < 0 ? std::nextafter(s, -std::numeric_limits<T>::infinity())
+                     : s;
+    }
+
+    // s + e rounded up
+    template <std::floating_point T>
+    auto round_up(T s, T e) -> T
+    {
+        return -round_down(-s, -e);
+    }
+
+    template <std::floating_point T>
+    auto sum_error(T a, T b, T s) -> T
+    {
+        const auto bv = s - a;
+        return (a - (s - bv)) + (b - bv);
+    }
+
+    template <std::floating_point T>
+    auto add_down(T a, T b) -> T
+    {
+        const auto s = a + b;
+        return round_down(s, sum_error(a, b, s));
+    }
+
+    template <std::floating_point T>
+    auto add_up(T a, T b) -> T
+    {
+        const auto s = a + b;
+        return round_up(s, sum_error(a, b, s));
+    }
+
+    // below this, the error of a product or quotient may itself underflow
+    // and is then not exact
+    template <std::floating_point T>
+    auto tiny() -> T
+    {
+        return std::ldexp(
+            std::numeric_limits<T>::min(), std::numeric_limits<T>::digits);
+    }
+
+    // the rounded result r of an operation on nonzero a with error sign
+    // from exact(), moved outward (dir = -1 down, +1 up)
+    template <std::floating_point T, typename Exact>
+    auto outward(T a, T r, int dir, Exact exact) -> T
+    {
+        constexpr auto inf = std::numeric_limits<T>::infinity();
+        if (std::isnan(r)) // 0 * inf, inf / inf: could be anything
+        {
+            return dir < 0 ? -inf : inf;
+        }
+        if (a == T(0))
+        {
+            return r; // exact
+        }
+        if (std::abs(r) < tiny<T>())
+        {
+            // a zero result keeps the sign of the exact one
+            if (r == T(0) && std::signbit(r) == (dir > 0))
+            {
+                return T(0);
+            }
+            return std::nextafter(r, dir < 0 ? -inf : inf);
+        }
+        const auto e = exact();
+        return dir < 0 ? round_down(r, e) : round_up(r, e);
+    }
+
+    template <std::floating_point T>
+    auto mul_down(T a, T b) -> T
+    {
+        const auto p = a * b;
+        return outward(b == T(0) ? b : a, p, -1,
+            [&] { return std::fma(a, b, -p); });
+    }
+
+    template <std::floating_point T>
+    auto mul_up(T a, T b) -> T
+    {
+        const auto p = a * b;
+        return outward(b == T(0) ? b : a, p, 1,
+            [&] { return std::fma(a, b, -p); });
+    }
+
+    // a / b = q + r / b exactly, so the error has the sign of r / b
+    template <std::floating_point T>
+    auto div_down(T a, T b) -> T
+    {
+        const auto q = a / b;
+        return outward(a, q, -1, [&] {
+            const auto r = std::fma(-q, b, a);
+            return b < 0 ? -r : r;
+        });
+    }
+
+    template <std::floating_point T>
+    auto div_up(T a, T b) -> T
+    {
+        const auto q = a / b;
+        return outward(a, q, 1, [&] {
+            const auto r = std::fma(-q, b, a);
+            return b < 0 ? -r : r;
+        });
+    }
+} // namespace detail
+
+/**
+ * @brief Closed interval [lo, hi] enclosing a real number
+ *
+ * The comparison operator<=> returns a std::partial_ordering, which is
+ * unordered when the intervals overlap, i.e. when the order of the
+ * enclosed numbers is uncertain. So a < b, a > b etc. hold only if they
+ * are certain, and a == b only if both are the same degenerate interval.
+ * certainly_zero() gives the three-valued answer.
+ *
+ * @tparam T floating point type
+ */
+template <std::floating_point T>
+class interval
+{
+    T _lo {0};
+    T _hi {0};
+
+  public:
+    /*!
+     * @brief Construct [0, 0]
+     *
+     */
+    constexpr interval() = default;
+
+    /*!
+     * @brief Construct [a, a]
+     *
+     * @param[in] a
+     */
+    constexpr interval(T a) // NOLINT(google-explicit-constructor)
+        : _lo {a}
+        , _hi {a}
+    {
+    }
+
+    /*!
+     * @brief Construct [lo, hi]
+     *
+     * @param[in] lo
+     * @param[in] hi
+     */
+    constexpr interval(T lo, T hi)
+        : _lo {lo}
+        , _hi {hi}
+    {
+        assert(!(hi < lo));
+    }
+
+    /*!
+     * @brief
+     *
+     * @return lower bound
+     */
+    [[nodiscard]] constexpr auto lo() const -> T
+    {
+        return this->_lo;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return upper bound
+     */
+    [[nodiscard]] constexpr auto hi() const -> T
+    {
+        return this->_hi;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return hi - lo, rounded up
+     */
+    [[nodiscard]] auto width() const -> T
+    {
+        return detail::add_up(this->_hi, -this->_lo);
+    }
+
+    /*!
+     * @brief
+     *
+     * @return midpoint
+     */
+    [[nodiscard]] constexpr auto mid() const -> T
+    {
+        return this->_lo / 2 + this->_hi / 2;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] x
+     * @return whether x is enclosed
+     */
+    [[nodiscard]] constexpr auto contains(T x) const -> bool
+    {
+        return this->_lo <= x && x <= this->_hi;
+    }
+
+    auto operator+=(const interval& b) -> interval&
+    {
+        this->_lo = detail::add_down(this->_lo, b._lo);
+        this->_hi = detail::add_up(this->_hi, b._hi);
+        return *this;
+    }
+
+    auto operator-=(const interval& b) -> interval&
+    {
+        return *this += -b;
+    }
+
+    auto operator*=(const interval& b) -> interval&
+    {
+        const auto& [a0, a1] = std::array {this->_lo, this->_hi};
+        const auto& [b0, b1] = std::array {b._lo, b._hi};
+        this->_lo = std::min({detail::mul_down(a0, b0),
+            detail::mul_down(a0, b1), detail::mul_down(a1, b0),
+            detail::mul_down(a1, b1)});
+        this->_hi = std::max({detail::mul_up(a0, b0), detail::mul_up(a0, b1),
+            detail::mul_up(a1, b0), detail::mul_up(a1, b1)});
+        return *this;
+    }
+
+    auto operator/=(const interval& b) -> interval&
+    {
+        if (b.contains(T(0)))
+        {
+            constexpr auto inf = std::numeric_limits<T>::infinity();
+            return *this = interval {-inf, inf};
+        }
+        const auto& [a0, a1] = std::array {this->_lo, this->_hi};
+        const auto& [b0, b1] = std::array {b._lo, b._hi};
+        this->_lo = std::min({detail::div_down(a0, b0),
+            detail::div_down(a0, b1), detail::div_down(a1, b0),
+            detail::div_down(a1, b1)});
+        this->_hi = std::max({detail::div_up(a0, b0), detail::div_up(a0, b1),
+            detail::div_up(a1, b0), detail::div_up(a1, b1)});
+        return *this;
+    }
+
+    constexpr auto operator-() const -> interval
+    {
+        return interval {-this->_hi, -this->_lo};
+    }
+
+    friend auto operator+(interval a, const interval& b) -> interval
+    {
+        return a += b;
+    }
+
+    friend auto operator-(interval a, const interval& b) -> interval
+    {
+        return a -= b;
+    }
+
+    friend auto operator*(interval a, const interval& b) -> interval
+    {
+        return a *= b;
+    }
+
+    friend auto operator/(interval a, const interval& b) -> interval
+    {
+        return a /= b;
+    }
+
+    friend constexpr auto operator==(const interval& a, const interval& b)
+        -> bool
+    {
+        return a._lo == a._hi && a._lo == b._lo && a._hi == b._hi;
+    }
+
+    friend constexpr auto operator<=>(const interval& a, const interval& b)
+        -> std::partial_ordering
+    {
+        if (a._hi < b._lo)
+        {
+            return std::partial_ordering::less;
+        }
+        if (a._lo > b._hi)
+        {
+            return std::partial_ordering::greater;
+        }
+        if (a == b)
+        {
+            return std::partial_ordering::equivalent;
+        }
+        return std::partial_ordering::unordered;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] a
+     * @return enclosure of |a|
+     */
+    friend constexpr auto abs(const interval& a) -> interval
+    {
+        if (a._lo >= 0)
+        {
+            return a;
+        }
+        if (a._hi <= 0)
+        {
+            return -a;
+        }
+        return interval {T(0), std::max(-a._lo, a._hi)};
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] a non-negative
+     * @return enclosure of sqrt(a)
+     */
+    friend auto sqrt(const interval& a) -> interval
+    {
+        const auto root = [](T x, bool up) {
+            const auto s = std::sqrt(x);
+            const auto e = std::fma(-s, s, x); // sign of the error of s
+            return up ? detail::round_up(s, e) : detail::round_down(s, e);
+        };
+        return interval {
+            root(std::max(a._lo, T(0)), false), root(a._hi, true)};
+    }
+
+    template <typename Stream>
+    friend auto operator<<(Stream& os, const interval& a) -> Stream&
+    {
+        os << '[' << a._lo << ", " << a._hi << ']';
+        return os;
+    }
+};
+
+/*!
+ * @brief Three-valued test for zero
+ *
+ * @tparam T
+ * @param[in] a
+ * @return true if a = [0, 0], false if 0 is not enclosed, indeterminate
+ *         otherwise (also for NaN bounds)
+ */
+template <std::floating_point T>
+auto certainly_zero(const interval<T>& a) -> boost::logic::tribool
+{
+    if (std::isnan(a.lo()) || std::isnan(a.hi()))
+    {
+        return boost::logic::indeterminate;
+    }
+    if (a == interval<T>(0))
+    {
+        return true;
+    }
+    if (!a.contains(T(0)))
+    {
+        return false;
+    }
+    return boost::logic::indeterminate;
+}
+
+/*!
+ * @brief Three-valued incidence of a point and a line (or a line and a
+ *        point) with interval coordinates
+ *
+ * @tparam P
+ * @tparam L
+ * @param[in] p
+ * @param[in] l
+ * @return boost::logic::tribool
+ */
+template <typename P, typename L>
+auto certified_incident(const P& p, const L& l) -> boost::logic::tribool
+{
+    return certainly_zero(p.dot(l));
+}
+
+/*!
+ * @brief Widest enclosure among the coordinates
+ *
+ * @tparam P point or line with interval coordinates
+ * @param[in] p
+ * @return width
+ */
+template <typename P>
+auto enclosure_width(const P& p)
+{
+    return std::max({p[0].width(), p[1].width(), p[2].width()});
+}
+
+} // namespace fun
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "euclid_plane.hpp" // import Ar
+#include "parallel.hpp"
+#include "proj_plane.hpp"
+#include "tri_eval.hpp" // import ck_term, ck_measure
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/*! @file include/mesh.hpp
+ *  This is a C++ Library header.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Triangle mesh: a shared vertex array plus index triangles
+ *
+ * @tparam P Point
+ */
+template <typename P>
+struct tri_mesh
+{
+    using face_t = std::array<std::size_t, 3>;
+
+    std::vector<P> vertices;
+    std::vector<face_t> faces;
+};
+
+/**
+ * @brief Per-edge and per-face quantities of a mesh in a ck plane
+ *
+ * Edge e joins the vertices edges[e][0] < edges[e][1]. face_edges[f][i] is
+ * the edge of face f opposite its i-th vertex, so quadrances[face_edges[f][i]]
+ * and spreads[f][i] play the roles of q_i and s_i in tri_quadrance and
+ * tri_spread(tri_dual(tri)).
+ *
+ * @tparam L Line
+ * @tparam Q_t quadrance type
+ * @tparam S_t spread type
+ */
+template <typename L, typename Q_t, typename S_t>
+struct mesh_props
+{
+    std::vector<std::array<std::size_t, 2>> edges;
+    std::vector<std::array<std::size_t, 3>> face_edges;
+    std::vector<L> sides; //!< join of the two ends of each edge
+    std::vector<Q_t> quadrances; //!< one per edge
+    std::vector<std::array<S_t, 3>> spreads; //!< one per face corner
+    std::vector<Q_t> quadreas; //!< Ar(q1, q2, q3), one per face
+};
+
+/*!
+ * @brief Unique edges of a mesh
+ *
+ * @param[in] faces
+ * @return the edges (sorted, with smaller vertex index first) and, for each
+ *         face, the index of the edge opposite each of its vertices
+ */
+inline auto mesh_edges(const std::vector<std::array<std::size_t, 3>>& faces)
+    -> std::pair<std::vector<std::array<std::size_t, 2>>,
+        std::vector<std::array<std::size_t, 3>>>
+{
+    // (edge, face corner) pairs, sorted so that shared edges are adjacent
+    auto corners =
+        std::vector<std::pair<std::array<std::size_t, 2>, std::size_t>> {};
+    corners.reserve(3 * faces.size());
+    for (auto f = 0U; f != faces.size(); ++f)
+    {
+        const auto& [v1, v2, v3] = faces[f];
+        corners.push_back({{std::min(v2, v3), std::max(v2, v3)}, 3 * f});
+        corners.push_back({{std::min(v1, v3), std::max(v1, v3)}, 3 * f + 1});
+        corners.push_back({{std::min(v1, v2), std::max(v1, v2)}, 3 * f + 2});
+    }
+    std::sort(corners.begin(), corners.end());
+
+    auto edges = std::vector<std::array<std::size_t, 2>> {};
+    auto face_edges = std::vector<std::array<std::size_t, 3>>(faces.size());
+    for (const auto& [e, c] : corners)
+    {
+        if (edges.empty() || edges.back() != e)
+        {
+            edges.push_back(e);
+        }
+        face_edges[c / 3][c % 3] = edges.size() - 1;
+    }
+    return {std::move(edges), std::move(face_edges)};
+}
+
+/*!
+ * @brief Evaluate quadrances, spreads and quadreas of a mesh in a ck plane
+ *
+ * The perp/omega of each vertex, and the join, perp/omega and quadrance of
+ * each edge, are computed once however many faces share them. Vertices,
+ * edges and faces are each processed in parallel.
+ *
+ * @param[in] pl
+ * @param[in] mesh
+ * @return mesh_props
+ */
+template <typename Plane, typename P>
+auto mesh_measure(const Plane& pl, const tri_mesh<P>& mesh)
+{
+    using L = typename P::dual;
+    using K = Value_type<P>;
+    using Q_t = decltype(pl.measure(std::declval<P>(), std::declval<P>()));
+    using S_t = decltype(pl.measure(std::declval<L>(), std::declval<L>()));
+
+    const auto& pts = mesh.vertices;
+    auto [edges, face_edges] = mesh_edges(mesh.faces);
+    const auto n_v = pts.size();
+    const auto n_e = edges.size();
+    const auto n_f = mesh.faces.size();
+
+    auto vertex_terms = std::vector<std::optional<ck_term<Plane, P>>>(n_v);
+    parallel_for(
+        n_v,
+        [&](std::size_t first, std::size_t last) {
+            for (auto v = first; v != last; ++v)
+            {
+                vertex_terms[v].emplace(pl, pts[v]);
+            }
+        },
+        64);
+
+    auto sides = std::vector<L>(n_e, L {K(0), K(0), K(0)});
+    auto side_terms = std::vector<std::optional<ck_term<Plane, L>>>(n_e);
+    auto quadrances = std::vector<Q_t>(n_e);
+    parallel_for(
+        n_e,
+        [&](std::size_t first, std::size_t last) {
+            for (auto e = first; e != last; ++e)
+            {
+                const auto [u, v] = edges[e];
+                sides[e] = pts[u] * pts[v];
+                side_terms[e].emplace(pl, sides[e]);
+                quadrances[e] = ck_measure(pl, pts[u], *vertex_terms[u],
+                    pts[v], *vertex_terms[v], sides[e]);
+            }
+        },
+        64);
+
+    const auto spread_of = [&](std::size_t e1, std::size_t e2) {
+        const auto& l1 = sides[e1];
+        const auto& l2 = sides[e2];
+        return ck_measure(pl, l1, *side_terms[e1], l2, *side_terms[e2],
+            detail::meet_if_needed<Plane>(l1, l2));
+    };
+    auto spreads = std::vector<std::array<S_t, 3>>(n_f);
+    auto quadreas = std::vector<Q_t>(n_f);
+    parallel_for(
+        n_f,
+        [&](std::size_t first, std::size_t last) {
+            for (auto f = first; f != last; ++f)
+            {
+                const auto [e1, e2, e3] = face_edges[f];
+                spreads[f] = {
+                    spread_of(e2, e3), spread_of(e1, e3), spread_of(e1, e2)};
+                quadreas[f] =
+                    Ar(quadrances[e1], quadrances[e2], quadrances[e3]);
+            }
+        },
+        64);
+
+    return mesh_props<L, Q_t, S_t> {std::move(edges), std::move(face_edges),
+        std::move(sides), std::move(quadrances), std::move(spreads),
+        std::move(quadreas)};
+}
+
+} // namespace fun
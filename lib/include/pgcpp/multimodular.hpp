@@ -0,0 +1,378 @@
+#pragma once
+
+#include "fractions.hpp"
+#include "gf_p.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*! @file include/multimodular.hpp
+ *  This is a C++ Library header.
+ *
+ *  Exact evaluation by computing modulo several word-sized primes and
+ *  Chinese remaindering. A computation written for a generic ring is run
+ *  with gf_p<> (run-time prime) instead of cpp_int; the residues are
+ *  combined into the exact integer, or by rational reconstruction into the
+ *  exact fraction, of each output value.
+ */
+
+namespace fun
+{
+
+/*!
+ * @brief Deterministic Miller-Rabin test for 32-bit integers
+ *
+ * @param[in] n
+ * @return true if n is prime
+ * @return false otherwise
+ */
+constexpr auto miller_rabin_u32(std::uint32_t n) -> bool
+{
+    if (n < 2)
+    {
+        return false;
+    }
+    for (std::uint32_t p : {2U, 3U, 5U, 7U, 11U, 13U})
+    {
+        if (n % p == 0)
+        {
+            return n == p;
+        }
+    }
+    auto d = n - 1;
+    auto s = 0;
+    for (; d % 2 == 0; d /= 2)
+    {
+        ++s;
+    }
+    const auto mul = [n](std::uint64_t a, std::uint64_t b) {
+        return a * b % n;
+    };
+    // the bases 2, 7, 61 are sufficient for n < 4759123141
+    for (std::uint64_t a : {2U, 7U, 61U})
+    {
+        auto x = std::uint64_t(1);
+        auto b = a % n;
+        for (auto e = d; e != 0; e >>= 1U)
+        {
+            if ((e & 1U) != 0)
+            {
+                x = mul(x, b);
+            }
+            b = mul(b, b);
+        }
+        if (x == 1 || x == n - 1)
+        {
+            continue;
+        }
+        auto composite = true;
+        for (auto r = 1; r < s && composite; ++r)
+        {
+            x = mul(x, x);
+            composite = (x != n - 1);
+        }
+        if (composite)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * @brief The largest primes below 2^31, in decreasing order
+ *
+ * @param[in] count
+ * @return std::vector<std::uint32_t>
+ */
+inline auto crt_primes(std::size_t count) -> std::vector<std::uint32_t>
+{
+    auto primes = std::vector<std::uint32_t> {};
+    primes.reserve(count);
+    for (auto n = (1U << 31U) - 1U; primes.size() != count; n -= 2)
+    {
+        if (miller_rabin_u32(n))
+        {
+            primes.push_back(n);
+        }
+    }
+    return primes;
+}
+
+/*!
+ * @brief Hadamard bound in bits on an n x n determinant (or any sum of n!
+ *        products of n entries) whose entries have at most entry_bits bits
+ *
+ * @param[in] n
+ * @param[in] entry_bits
+ * @return std::size_t
+ */
+inline auto hadamard_bits(std::size_t n, std::size_t entry_bits)
+    -> std::size_t
+{
+    // |det| <= (sqrt(n) 2^entry_bits)^n
+    return n * entry_bits +
+        std::size_t(std::ceil(double(n) * std::log2(double(n)) / 2.));
+}
+
+/*!
+ * @brief Residue of an integer modulo the current prime of gf_p<>
+ *
+ * @param[in] z
+ * @return gf_p<>
+ */
+template <Integral Z>
+auto to_gf_p(const Z& z) -> gf_p<>
+{
+    return gf_p<>(static_cast<std::int64_t>(Z(z % Z(gf_p<>::modulus()))));
+}
+
+/*!
+ * @brief Rational reconstruction
+ *
+ * @param[in] u residue in [0, m)
+ * @param[in] m modulus
+ * @return a / b with a == u b (mod m) and |a|, |b| <= sqrt(m / 2), or
+ *         std::nullopt if there is none
+ */
+inline auto rational_reconstruct(const boost::multiprecision::cpp_int& u,
+    const boost::multiprecision::cpp_int& m)
+    -> std::optional<Fraction<boost::multiprecision::cpp_int>>
+{
+    using boost::multiprecision::cpp_int;
+    const auto bound = cpp_int(sqrt(cpp_int(m / 2)));
+    auto r0 = m;
+    auto r1 = u;
+    auto t0 = cpp_int(0);
+    auto t1 = cpp_int(1);
+    while (r1 > bound)
+    {
+        const auto q = cpp_int(r0 / r1);
+        r0 = std::exchange(r1, cpp_int(r0 - q * r1));
+        t0 = std::exchange(t1, cpp_int(t0 - q * t1));
+    }
+    if (t1 == 0 || boost::multiprecision::abs(t1) > bound ||
+        boost::multiprecision::gcd(r1, t1) != 1)
+    {
+        return std::nullopt;
+    }
+    if (t1 < 0)
+    {
+        return Fraction<cpp_int>(cpp_int(-r1), cpp_int(-t1));
+    }
+    return Fraction<cpp_int>(std::move(r1), std::move(t1));
+}
+
+/**
+ * @brief Options of crt_eval and crt_eval_rational
+ *
+ */
+struct crt_options
+{
+    /// Bound in bits on |result| (crt_eval), or on |num| |den|
+    /// (crt_eval_rational, which then uses about twice as many primes),
+    /// e.g. from hadamard_bits. If 0, primes are added until the
+    /// reconstruction no longer changes.
+    std::size_t bits = 0;
+    std::size_t max_primes = 64; //!< give up after this many primes
+    std::size_t batch = 4; //!< primes evaluated in parallel per round
+};
+
+namespace detail
+{
+    template <typename T>
+    struct is_gf_fraction : std::false_type
+    {
+    };
+
+    template <>
+    struct is_gf_fraction<Fraction<gf_p<>>> : std::true_type
+    {
+    };
+
+    // residues of fn() modulo p; std::nullopt if a denominator vanishes
+    template <typename Fn>
+    auto eval_mod(Fn& fn, std::uint32_t p)
+        -> std::optional<std::vector<std::uint32_t>>
+    {
+        const auto field = gf_p<>::scoped_modulus {p};
+        const auto res = fn();
+        auto out = std::vector<std::uint32_t> {};
+        for (const auto& x : res)
+        {
+            using T = std::remove_cvref_t<decltype(x)>;
+            if constexpr (is_gf_fraction<T>::value)
+            {
+                if (x.den() == 0)
+                {
+                    return std::nullopt;
+                }
+                out.push_back((x.num() / x.den()).value());
+            }
+            else
+            {
+                out.push_back(gf_p<>(x).value());
+            }
+        }
+        return out;
+    }
+
+    // Chinese remaindering of the residues of the (good) primes so far,
+    // then reconstruct() of each value, which returns std::optional;
+    // with opt.bits != 0, the product of the primes must exceed 2^mod_bits
+    template <typename Fn, typename Rec>
+    auto crt_run(Fn& fn, const crt_options& opt, std::size_t mod_bits,
+        Rec reconstruct)
+    {
+        using boost::multiprecision::cpp_int;
+        using R = typename decltype(reconstruct(
+            std::declval<const cpp_int&>(),
+            std::declval<const cpp_int&>()))::value_type;
+
+        const auto primes = crt_primes(opt.max_primes);
+        const auto needed = mod_bits / 30 + 1; // each prime is above 2^30
+        auto x = std::vector<cpp_int> {};
+        auto M = cpp_int(1);
+        auto n_good = std::size_t(0);
+        auto last = std::vector<std::optional<R>> {};
+
+        // all values, if they could all be reconstructed
+        const auto all_of = [](const std::vector<std::optional<R>>& vals)
+            -> std::optional<std::vector<R>> {
+            auto out = std::vector<R> {};
+            for (const auto& v : vals)
+            {
+                if (!v)
+                {
+                    return std::nullopt;
+                }
+                out.push_back(*v);
+            }
+            return out;
+        };
+
+        for (auto next = std::size_t(0); next < primes.size();)
+        {
+            const auto n = std::min(
+                opt.bits != 0 ? std::max(needed - n_good, opt.batch)
+                              : opt.batch,
+                primes.size() - next);
+            auto res =
+                std::vector<std::optional<std::vector<std::uint32_t>>>(n);
+            parallel_for(
+                n,
+                [&](std::size_t first, std::size_t stop) {
+                    for (auto i = first; i != stop; ++i)
+                    {
+                        res[i] = eval_mod(fn, primes[next + i]);
+                    }
+                },
+                1);
+
+            for (auto i = 0U; i != n; ++i)
+            {
+                if (!res[i])
+                {
+                    continue; // unlucky prime
+                }
+                const auto p = primes[next + i];
+                const auto& r = *res[i];
+                x.resize(r.size());
+                // x += M ((r - x) M^-1 mod p), keeping 0 <= x < M p
+                const auto field = gf_p<>::scoped_modulus {p};
+                const auto m_inv =
+                    gf_p<>(static_cast<std::int64_t>(cpp_int(M % p))).inv();
+                for (auto k = 0U; k != r.size(); ++k)
+                {
+                    const auto xp =
+                        static_cast<std::int64_t>(cpp_int(x[k] % p));
+                    const auto t = (gf_p<>(r[k]) - gf_p<>(xp)) * m_inv;
+                    x[k] += M * t.value();
+                }
+                M *= p;
+                ++n_good;
+                if (opt.bits != 0 && n_good < needed)
+                {
+                    continue;
+                }
+
+                auto cur = std::vector<std::optional<R>> {};
+                for (const auto& v : x)
+                {
+                    cur.push_back(reconstruct(v, M));
+                }
+                if (opt.bits != 0)
+                {
+                    return all_of(cur);
+                }
+                if (n_good > 1 && cur == last)
+                {
+                    if (auto out = all_of(cur))
+                    {
+                        return out;
+                    }
+                }
+                last = std::move(cur);
+            }
+            next += n;
+        }
+        return std::optional<std::vector<R>> {};
+    }
+} // namespace detail
+
+/*!
+ * @brief Exact integer values of fn() from its values modulo several primes
+ *
+ * fn is called once per prime, on a thread whose gf_p<> modulus is that
+ * prime, and must return a range of gf_p<> values (e.g. a pg_point<gf_p<>>
+ * or a std::vector<gf_p<>>); inputs are reduced with to_gf_p. The values
+ * are reconstructed in the symmetric range (-M/2, M/2] of the product M of
+ * the primes, so they are exact once |value| < M / 2.
+ *
+ * @param[in] fn
+ * @param[in] opt
+ * @return the values, or std::nullopt if opt.max_primes did not suffice
+ */
+template <typename Fn>
+auto crt_eval(Fn&& fn, const crt_options& opt = {})
+    -> std::optional<std::vector<boost::multiprecision::cpp_int>>
+{
+    using boost::multiprecision::cpp_int;
+    // |value| < M / 2: one extra bit for the sign
+    return detail::crt_run(
+        fn, opt, opt.bits + 1, [](const cpp_int& v, const cpp_int& M) {
+            return std::optional<cpp_int> {2 * v > M ? cpp_int(v - M) : v};
+        });
+}
+
+/*!
+ * @brief Exact rational values of fn() from its values modulo several
+ *        primes
+ *
+ * As crt_eval, but the values may also be Fraction<gf_p<>> (e.g. the
+ * measures of ellck) and are reconstructed as fractions. Primes dividing a
+ * denominator are skipped.
+ *
+ * @param[in] fn
+ * @param[in] opt
+ * @return the values, or std::nullopt if opt.max_primes did not suffice
+ */
+template <typename Fn>
+auto crt_eval_rational(Fn&& fn, const crt_options& opt = {})
+    -> std::optional<std::vector<Fraction<boost::multiprecision::cpp_int>>>
+{
+    using boost::multiprecision::cpp_int;
+    // M > 2 max(|num|, |den|)^2, where max(|num|, |den|) <= |num| |den|
+    return detail::crt_run(
+        fn, opt, 2 * opt.bits + 2, [](const cpp_int& v, const cpp_int& M) {
+            return rational_reconstruct(v, M);
+        });
+}
+
+} // namespace fun
@@ -0,0 +1,466 @@
+/*! @file include/parallel.hpp
+ *  This is a C++ Library header.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fun
+{
+
+/**
+ * @brief Small work-stealing thread pool for index ranges
+ *
+ * run(n, func, grain) splits [0, n) into ranges processed by the pool
+ * threads and by the calling thread. Every participant has its own deque
+ * of ranges: it takes work from the back of its own deque and, when that
+ * is empty, steals from the front of the others'. A taken range is halved
+ * repeatedly, the upper halves being pushed for others to steal, as long
+ * as both halves keep at least grain items. So a thread that draws cheap
+ * items keeps stealing from one that draws expensive ones (e.g. large
+ * cpp_int values) instead of idling as with fixed chunks.
+ *
+ * func receives a slot number, unique among the threads working on the
+ * same run() and less than size() + 1, which can index per-thread scratch
+ * state. The calling thread always takes part in its own run(), so
+ * run() may be called from inside func.
+ *
+ * If func throws, the remaining ranges are skipped, run() waits until no
+ * thread is inside func any more and then rethrows the first exception in
+ * the calling thread.
+ */
+class work_stealing_pool
+{
+    using range_t = std::pair<std::size_t, std::size_t>;
+
+    struct range_queue
+    {
+        std::mutex mtx;
+        std::deque<range_t> ranges;
+    };
+
+    struct job
+    {
+        std::function<void(std::size_t, std::size_t, std::size_t)> func;
+        std::size_t grain;
+        std::vector<range_queue> queues; // one per slot
+        std::atomic<std::size_t> queued {0}; // ranges in the queues
+        std::atomic<std::size_t> remaining; // items not yet processed
+        std::atomic<bool> failed {false}; // skip the remaining ranges
+        std::exception_ptr error; // first exception thrown by func
+        std::mutex done_mtx;
+        std::condition_variable done_cv;
+
+        job(std::function<void(std::size_t, std::size_t, std::size_t)> fn,
+            std::size_t n, std::size_t grain_, std::size_t n_slots)
+            : func {std::move(fn)}
+            , grain {std::max<std::size_t>(grain_, 1)}
+            , queues(n_slots)
+            , remaining {n}
+        {
+        }
+    };
+
+    std::vector<std::thread> _workers;
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::vector<std::shared_ptr<job>> _jobs;
+    std::size_t _idle {0};
+    bool _stop {false};
+
+    static inline thread_local const work_stealing_pool* tls_pool {nullptr};
+    static inline thread_local std::size_t tls_slot {0};
+
+  public:
+    /*!
+     * @brief Construct a new work stealing pool object
+     *
+     * @param[in] n_threads number of pool threads, in addition to the
+     *            threads calling run()
+     */
+    explicit work_stealing_pool(std::size_t n_threads)
+    {
+        this->_workers.reserve(n_threads);
+        for (auto id = 0U; id != n_threads; ++id)
+        {
+            this->_workers.emplace_back([this, id] { this->work(id); });
+        }
+    }
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    auto operator=(const work_stealing_pool&) -> work_stealing_pool& = delete;
+
+    /*!
+     * @brief Destroy the work stealing pool object
+     *
+     */
+    ~work_stealing_pool()
+    {
+        {
+            auto lock = std::lock_guard {this->_mtx};
+            this->_stop = true;
+        }
+        this->_cv.notify_all();
+        for (auto& t : this->_workers)
+        {
+            t.join();
+        }
+    }
+
+    /*!
+     * @brief number of pool threads
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->_workers.size();
+    }
+
+    /*!
+     * @brief Apply func(slot, first, last) to ranges covering [0, n)
+     *
+     * Returns when every item has been processed. If func throws, the
+     * first exception is rethrown once no call of func is running.
+     *
+     * @tparam Fn
+     * @param[in] n number of items
+     * @param[in] func callable taking (slot, first, last)
+     * @param[in] grain minimum number of items per call (unless n is
+     *            smaller)
+     */
+    template <typename Fn>
+    void run(std::size_t n, Fn&& func, std::size_t grain)
+    {
+        const auto n_slots = this->size() + 1;
+        const auto slot =
+            (tls_pool == this) ? tls_slot : n_slots - 1; // caller's own slot
+        if (n == 0)
+        {
+            return;
+        }
+        if (this->_workers.empty() || n <= grain)
+        {
+            func(slot, std::size_t(0), n);
+            return;
+        }
+
+        auto jb = std::make_shared<job>(std::ref(func), n, grain, n_slots);
+        // seed up to every deque with ranges of at least one grain, so
+        // that all threads start without stealing
+        const auto n_seeds = std::min(n_slots, n / jb->grain);
+        for (auto s = 0U; s != n_seeds; ++s)
+        {
+            jb->queues[s].ranges.emplace_back(
+                n * s / n_seeds, n * (s + 1) / n_seeds);
+            ++jb->queued;
+        }
+        {
+            auto lock = std::lock_guard {this->_mtx};
+            this->_jobs.push_back(jb);
+        }
+        this->_cv.notify_all();
+
+        this->participate(*jb, slot);
+        {
+            auto lock = std::unique_lock {jb->done_mtx};
+            jb->done_cv.wait(lock, [&] { return jb->remaining == 0; });
+        }
+        {
+            auto lock = std::lock_guard {this->_mtx};
+            std::erase(this->_jobs, jb);
+        }
+        if (jb->error)
+        {
+            std::rethrow_exception(jb->error);
+        }
+    }
+
+  private:
+    void work(std::size_t id)
+    {
+        tls_pool = this;
+        tls_slot = id;
+        for (;;)
+        {
+            auto jb = std::shared_ptr<job> {};
+            {
+                auto lock = std::unique_lock {this->_mtx};
+                ++this->_idle;
+                this->_cv.wait(lock, [&] {
+                    if (this->_stop)
+                    {
+                        return true;
+                    }
+                    for (const auto& j : this->_jobs)
+                    {
+                        if (j->queued != 0)
+                        {
+                            jb = j;
+                            return true;
+                        }
+                    }
+                    return false;
+                });
+                --this->_idle;
+                if (this->_stop)
+                {
+                    return;
+                }
+            }
+            this->participate(*jb, id);
+        }
+    }
+
+    // process ranges of jb until none can be taken or stolen; after an
+    // exception the ranges are only counted, so that run() can return
+    void participate(job& jb, std::size_t slot)
+    {
+        while (auto r = take(jb, slot))
+        {
+            auto [first, last] = *r;
+            if (!jb.failed)
+            {
+                while (last - first >= 2 * jb.grain)
+                {
+                    const auto mid = first + (last - first) / 2;
+                    this->push(jb, slot, {mid, last});
+                    last = mid;
+                }
+                try
+                {
+                    jb.func(slot, first, last);
+                }
+                catch (...)
+                {
+                    auto lock = std::lock_guard {jb.done_mtx};
+                    if (!jb.error)
+                    {
+                        jb.error = std::current_exception();
+                    }
+                    jb.failed = true;
+                }
+            }
+            const auto count = last - first;
+            if (jb.remaining.fetch_sub(count) == count)
+            {
+                auto lock = std::lock_guard {jb.done_mtx};
+                jb.done_cv.notify_all();
+            }
+        }
+    }
+
+    void push(job& jb, std::size_t slot, range_t r)
+    {
+        {
+            auto& q = jb.queues[slot];
+            auto lock = std::lock_guard {q.mtx};
+            q.ranges.push_back(r);
+            ++jb.queued;
+        }
+        auto lock = std::lock_guard {this->_mtx};
+        if (this->_idle != 0)
+        {
+            this->_cv.notify_one();
+        }
+    }
+
+    static auto take(job& jb, std::size_t slot) -> std::optional<range_t>
+    {
+        const auto n_slots = jb.queues.size();
+        for (auto k = 0U; k != n_slots; ++k)
+        {
+            auto& q = jb.queues[(slot + k) % n_slots];
+            auto lock = std::lock_guard {q.mtx};
+            if (q.ranges.empty())
+            {
+                continue;
+            }
+            auto r = range_t {};
+            if (k == 0) // own deque: newest (smallest) range
+            {
+                r = q.ranges.back();
+                q.ranges.pop_back();
+            }
+            else // steal the oldest (largest) range
+            {
+                r = q.ranges.front();
+                q.ranges.pop_front();
+            }
+            --jb.queued;
+            return r;
+        }
+        return std::nullopt;
+    }
+};
+
+/*!
+ * @brief The pool used by parallel_for, with hardware_concurrency() - 1
+ *        threads (the caller being the last one)
+ *
+ * @return work_stealing_pool&
+ */
+inline auto default_pool() -> work_stealing_pool&
+{
+    static auto pool = work_stealing_pool {
+        std::max(1U, std::thread::hardware_concurrency()) - 1U};
+    return pool;
+}
+
+/*!
+ * @brief Apply func(first, last) to contiguous chunks of [0, n)
+ *
+ * Chunks are at least grain items long (unless n is smaller) and are
+ * balanced over the threads of default_pool() by work stealing. Inputs of
+ * at most one grain run on the calling thread. An exception thrown by
+ * func is rethrown here once all the chunks have been settled.
+ *
+ * @tparam Fn
+ * @param[in] n number of items
+ * @param[in] func callable taking (std::size_t first, std::size_t last)
+ * @param[in] grain minimum number of items per chunk
+ */
+template <typename Fn>
+void parallel_for(std::size_t n, Fn&& func, std::size_t grain = 1024)
+{
+    default_pool().run(
+        n,
+        [&func](std::size_t /* slot */, std::size_t first, std::size_t last) {
+            func(first, last);
+        },
+        grain);
+}
+
+/*!
+ * @brief Apply func(scratch, first, last) to contiguous chunks of [0, n)
+ *
+ * Each thread taking part gets its own scratch object, created by
+ * make_scratch() on first use and reused for all its chunks, e.g. to keep
+ * the storage of cpp_int temporaries.
+ *
+ * @tparam Make
+ * @tparam Fn
+ * @param[in] n number of items
+ * @param[in] make_scratch callable returning a new scratch object
+ * @param[in] func callable taking (scratch&, first, last)
+ * @param[in] grain minimum number of items per chunk
+ */
+template <typename Make, typename Fn>
+void parallel_for_scratch(
+    std::size_t n, Make&& make_scratch, Fn&& func, std::size_t grain = 1024)
+{
+    auto& pool = default_pool();
+    using S = std::invoke_result_t<Make&>;
+    auto scratch = std::vector<std::optional<S>>(pool.size() + 1);
+    pool.run(
+        n,
+        [&](std::size_t slot, std::size_t first, std::size_t last) {
+            auto& s = scratch[slot];
+            if (!s)
+            {
+                s.emplace(make_scratch());
+            }
+            func(*s, first, last);
+        },
+        grain);
+}
+
+/*!
+ * @brief Parallel for_each over a random-access range
+ *
+ * @param[in,out] rng
+ * @param[in] func applied to each element
+ * @param[in] grain minimum number of items per chunk
+ */
+template <typename Rng, typename Fn>
+void par_for_each(Rng&& rng, Fn&& func, std::size_t grain = 64)
+{
+    auto first = std::begin(rng);
+    parallel_for(
+        std::size(rng),
+        [&](std::size_t lo, std::size_t hi) {
+            for (auto i = lo; i != hi; ++i)
+            {
+                func(first[i]);
+            }
+        },
+        grain);
+}
+
+/*!
+ * @brief Parallel transform of a random-access range
+ *
+ * out[i] = op(in[i]), so the output order does not depend on the
+ * scheduling.
+ *
+ * @param[in] in
+ * @param[out] out must have at least as many elements as in
+ * @param[in] op
+ * @param[in] grain minimum number of items per chunk
+ */
+template <typename In, typename Out, typename Op>
+requires std::is_invocable_v<Op&,
+    decltype(*std::begin(std::declval<const In&>()))>
+void par_transform(const In& in, Out&& out, Op&& op, std::size_t grain = 64)
+{
+    auto src = std::begin(in);
+    auto dst = std::begin(out);
+    parallel_for(
+        std::size(in),
+        [&](std::size_t lo, std::size_t hi) {
+            for (auto i = lo; i != hi; ++i)
+            {
+                dst[i] = op(src[i]);
+            }
+        },
+        grain);
+}
+
+/*!
+ * @brief Parallel transform of two random-access ranges
+ *
+ * out[i] = op(in1[i], in2[i]), e.g. pairwise meets or measures.
+ *
+ * @param[in] in1
+ * @param[in] in2 must have at least as many elements as in1
+ * @param[out] out must have at least as many elements as in1
+ * @param[in] op
+ * @param[in] grain minimum number of items per chunk
+ */
+template <typename In1, typename In2, typename Out, typename Op>
+requires std::is_invocable_v<Op&,
+    decltype(*std::begin(std::declval<const In1&>())),
+    decltype(*std::begin(std::declval<const In2&>()))>
+void par_transform(const In1& in1, const In2& in2, Out&& out, Op&& op,
+    std::size_t grain = 64)
+{
+    auto src1 = std::begin(in1);
+    auto src2 = std::begin(in2);
+    auto dst = std::begin(out);
+    parallel_for(
+        std::size(in1),
+        [&](std::size_t lo, std::size_t hi) {
+            for (auto i = lo; i != hi; ++i)
+            {
+                dst[i] = op(src1[i], src2[i]);
+            }
+        },
+        grain);
+}
+
+} // namespace fun
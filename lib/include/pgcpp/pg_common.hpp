@@ -5,6 +5,7 @@
 #pragma once
 
 #include "common_concepts.h"
+#include "fractions.hpp" // import gcd
 #include <array>
 #include <tuple>
 
@@ -144,4 +145,146 @@ constexpr inline auto sq(const T& a)
     return a * a;
 }
 
+/// 3x3 matrix stored row by row
+template <ring _K>
+using Mat3 = std::array<std::array<_K, 3>, 3>;
+
+/*!
+ * @brief Matrix-vector product
+ *
+ * @tparam _K
+ * @param[in] A
+ * @param[in] v
+ * @return A * v
+ */
+template <ring _K>
+constexpr auto mat3_vec(const Mat3<_K>& A, const std::array<_K, 3>& v)
+    -> std::array<_K, 3>
+{
+    return {dot_c(A[0], v), dot_c(A[1], v), dot_c(A[2], v)};
+}
+
+/*!
+ * @brief Transposed matrix-vector product
+ *
+ * @tparam _K
+ * @param[in] A
+ * @param[in] v
+ * @return A^T * v
+ */
+template <ring _K>
+constexpr auto mat3_tvec(const Mat3<_K>& A, const std::array<_K, 3>& v)
+    -> std::array<_K, 3>
+{
+    const auto& [x, y, z] = v;
+    return {A[0][0] * x + A[1][0] * y + A[2][0] * z,
+        A[0][1] * x + A[1][1] * y + A[2][1] * z,
+        A[0][2] * x + A[1][2] * y + A[2][2] * z};
+}
+
+/*!
+ * @brief Matrix product
+ *
+ * @tparam _K
+ * @param[in] A
+ * @param[in] B
+ * @return A * B
+ */
+template <ring _K>
+constexpr auto mat3_mul(const Mat3<_K>& A, const Mat3<_K>& B) -> Mat3<_K>
+{
+    auto C = A;
+    for (auto i = 0U; i != 3; ++i)
+    {
+        for (auto j = 0U; j != 3; ++j)
+        {
+            C[i][j] = A[i][0] * B[0][j] + A[i][1] * B[1][j] + A[i][2] * B[2][j];
+        }
+    }
+    return C;
+}
+
+/*!
+ * @brief Adjugate matrix, i.e. adj(A) * A = det(A) * I
+ *
+ * The rows of adj(A) are the cross products of the columns of A.
+ *
+ * @tparam _K
+ * @param[in] A
+ * @return adj(A)
+ */
+template <ring _K>
+constexpr auto mat3_adj(const Mat3<_K>& A) -> Mat3<_K>
+{
+    const auto c0 = std::array<_K, 3> {A[0][0], A[1][0], A[2][0]};
+    const auto c1 = std::array<_K, 3> {A[0][1], A[1][1], A[2][1]};
+    const auto c2 = std::array<_K, 3> {A[0][2], A[1][2], A[2][2]};
+    return {cross(c1, c2), cross(c2, c0), cross(c0, c1)};
+}
+
+/*!
+ * @brief Determinant
+ *
+ * @tparam _K
+ * @param[in] A
+ * @return det(A)
+ */
+template <ring _K>
+constexpr auto mat3_det(const Mat3<_K>& A) -> _K
+{
+    return dot_c(A[0], cross(A[1], A[2]));
+}
+
+/*!
+ * @brief Divide a matrix by the gcd of its entries and make the first
+ *        nonzero entry positive
+ *
+ * @tparam Z
+ * @param[in,out] H
+ */
+template <Integral Z>
+constexpr void reduce_mat3(Mat3<Z>& H)
+{
+    auto common = Z(0);
+    for (const auto& row : H)
+    {
+        for (const auto& a : row)
+        {
+            common = gcd(common, a);
+        }
+    }
+    if (common == Z(0))
+    {
+        return;
+    }
+    const auto first_nonzero = [&H]() -> const Z& {
+        for (const auto& row : H)
+        {
+            for (const auto& a : row)
+            {
+                if (a != Z(0))
+                {
+                    return a;
+                }
+            }
+        }
+        return H[2][2];
+    };
+    if (first_nonzero() < Z(0))
+    {
+        common = -common;
+    }
+    if (common == Z(1))
+    {
+        return;
+    }
+    for (auto& row : H)
+    {
+        for (auto& a : row)
+        {
+            a /= common;
+        }
+    }
+}
+
 } // namespace fun
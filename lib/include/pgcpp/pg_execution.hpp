@@ -0,0 +1,243 @@
+#pragma once
+
+#include "euclid_plane.hpp"
+#include "euclid_plane_measure.hpp"
+#include "proj_plane.hpp"
+#include "proj_plane_measure.hpp"
+#include <algorithm>
+#include <concepts>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+/*! @file include/pg_execution.hpp
+ *  This is a C++ Library header.
+ *
+ *  Overloads of the free functions of euclid_plane.hpp,
+ *  euclid_plane_measure.hpp and proj_plane_measure.hpp taking an execution
+ *  policy and iterator ranges, in the style of std::transform. With
+ *  libstdc++ the parallel policies run on TBB when it is available (see
+ *  the top-level CMakeLists.txt) and sequentially otherwise. Without
+ *  <execution> at all, fun::execution provides policy tags that are
+ *  accepted and ignored.
+ */
+
+namespace fun
+{
+
+#if defined(__cpp_lib_execution)
+
+namespace execution = std::execution;
+
+/*!
+ * @brief Standard execution policy
+ */
+template <typename E>
+concept Execution_policy = std::is_execution_policy_v<std::remove_cvref_t<E>>;
+
+#else
+
+namespace execution
+{
+    struct sequenced_policy
+    {
+    };
+    struct parallel_policy
+    {
+    };
+    struct parallel_unsequenced_policy
+    {
+    };
+    inline constexpr sequenced_policy seq {};
+    inline constexpr parallel_policy par {};
+    inline constexpr parallel_unsequenced_policy par_unseq {};
+} // namespace execution
+
+/*!
+ * @brief Placeholder execution policy (run sequentially)
+ */
+template <typename E>
+concept Execution_policy =
+    std::same_as<std::remove_cvref_t<E>, execution::sequenced_policy> ||
+    std::same_as<std::remove_cvref_t<E>, execution::parallel_policy> ||
+    std::same_as<std::remove_cvref_t<E>, execution::parallel_unsequenced_policy>;
+
+#endif
+
+namespace detail
+{
+    template <Execution_policy E, typename It, typename Out, typename Op>
+    inline auto exec_transform(
+        [[maybe_unused]] E&& policy, It first, It last, Out d_first, Op op)
+        -> Out
+    {
+#if defined(__cpp_lib_execution)
+        return std::transform(
+            std::forward<E>(policy), first, last, d_first, op);
+#else
+        return std::transform(first, last, d_first, op);
+#endif
+    }
+
+    template <Execution_policy E, typename It1, typename It2, typename Out,
+        typename Op>
+    inline auto exec_transform([[maybe_unused]] E&& policy, It1 first1,
+        It1 last1, It2 first2, Out d_first, Op op) -> Out
+    {
+#if defined(__cpp_lib_execution)
+        return std::transform(
+            std::forward<E>(policy), first1, last1, first2, d_first, op);
+#else
+        return std::transform(first1, last1, first2, d_first, op);
+#endif
+    }
+} // namespace detail
+
+/*!
+ * @brief quadrance(*first1, *first2) for each pair of points
+ *
+ * @param[in] policy
+ * @param[in] first1
+ * @param[in] last1
+ * @param[in] first2
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It1, typename It2, typename Out>
+auto quadrance(E&& policy, It1 first1, It1 last1, It2 first2, Out d_first)
+    -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first1, last1,
+        first2, d_first,
+        [](const auto& a1, const auto& a2) { return quadrance(a1, a2); });
+}
+
+/*!
+ * @brief spread(*first1, *first2) for each pair of lines
+ *
+ * @param[in] policy
+ * @param[in] first1
+ * @param[in] last1
+ * @param[in] first2
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It1, typename It2, typename Out>
+auto spread(E&& policy, It1 first1, It1 last1, It2 first2, Out d_first)
+    -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first1, last1,
+        first2, d_first,
+        [](const auto& l1, const auto& l2) { return spread(l1, l2); });
+}
+
+/*!
+ * @brief midpoint(*first1, *first2) for each pair of points
+ *
+ * @param[in] policy
+ * @param[in] first1
+ * @param[in] last1
+ * @param[in] first2
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It1, typename It2, typename Out>
+auto midpoint(E&& policy, It1 first1, It1 last1, It2 first2, Out d_first)
+    -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first1, last1,
+        first2, d_first,
+        [](const auto& a, const auto& b) { return midpoint(a, b); });
+}
+
+/*!
+ * @brief tri_quadrance of each triangle
+ *
+ * @param[in] policy
+ * @param[in] first
+ * @param[in] last
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It, typename Out>
+auto tri_quadrance(E&& policy, It first, It last, Out d_first) -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first, last,
+        d_first, [](const auto& tri) { return tri_quadrance(tri); });
+}
+
+/*!
+ * @brief tri_spread of each trilateral
+ *
+ * @param[in] policy
+ * @param[in] first
+ * @param[in] last
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It, typename Out>
+auto tri_spread(E&& policy, It first, It last, Out d_first) -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first, last,
+        d_first, [](const auto& trilateral) { return tri_spread(trilateral); });
+}
+
+/*!
+ * @brief orthocenter of each triangle
+ *
+ * @param[in] policy
+ * @param[in] first
+ * @param[in] last
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It, typename Out>
+auto orthocenter(E&& policy, It first, It last, Out d_first) -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first, last,
+        d_first, [](const auto& tri) { return orthocenter(tri); });
+}
+
+/*!
+ * @brief R(A, B, C, D) for each quadruple of points
+ *
+ * @param[in] policy
+ * @param[in] first
+ * @param[in] last
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It, typename Out>
+auto R(E&& policy, It first, It last, Out d_first) -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first, last,
+        d_first, [](const auto& quad) {
+            return std::apply(
+                [](const auto&... x) { return R(x...); }, quad);
+        });
+}
+
+/*!
+ * @brief x_ratio(A, B, l, m) for each tuple (A, B, l, m)
+ *
+ * @param[in] policy
+ * @param[in] first
+ * @param[in] last
+ * @param[out] d_first
+ * @return end of the output range
+ */
+template <Execution_policy E, typename It, typename Out>
+auto x_ratio(E&& policy, It first, It last, Out d_first) -> Out
+{
+    return detail::exec_transform(std::forward<E>(policy), first, last,
+        d_first, [](const auto& quad) {
+            return std::apply(
+                [](const auto&... x) { return x_ratio(x...); }, quad);
+        });
+}
+
+} // namespace fun
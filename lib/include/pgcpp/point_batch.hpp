@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*! @file include/point_batch.hpp
+ *  This is a C++ Library header.
+ *
+ *  Column (structure-of-arrays) storage of homogeneous coordinates, shared
+ *  by the batched kernels of tri_batch.hpp and rescale.hpp.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Homogeneous coordinates of n points (or lines) stored by column
+ *
+ * @tparam K
+ */
+template <typename K>
+struct point_batch
+{
+    std::vector<K> x;
+    std::vector<K> y;
+    std::vector<K> z;
+
+    /*!
+     * @brief
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->x.size();
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] n
+     */
+    void resize(std::size_t n)
+    {
+        this->x.resize(n);
+        this->y.resize(n);
+        this->z.resize(n);
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] n
+     */
+    void reserve(std::size_t n)
+    {
+        this->x.reserve(n);
+        this->y.reserve(n);
+        this->z.reserve(n);
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] p point or line
+     */
+    template <typename P>
+    void push_back(const P& p)
+    {
+        this->x.push_back(p[0]);
+        this->y.push_back(p[1]);
+        this->z.push_back(p[2]);
+    }
+
+    /*!
+     * @brief the i-th entry as an object of type P
+     *
+     * @tparam P point or line
+     * @param[in] i
+     * @return P
+     */
+    template <typename P>
+    [[nodiscard]] auto get(std::size_t i) const -> P
+    {
+        return P {this->x[i], this->y[i], this->z[i]};
+    }
+};
+
+} // namespace fun
@@ -0,0 +1,597 @@
+#pragma once
+
+#include "fractions.hpp"
+#include <algorithm>
+#include <array>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*! @file include/poly.hpp
+ *  This is a C++ Library header.
+ *
+ *  Sparse multivariate polynomials with integer coefficients, so that the
+ *  constructions of pg_point, ck etc. can be expanded symbolically, e.g.
+ *  pg_point<poly> or Fraction<poly>.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Monomial in up to 16 variables, with exponents up to 255 packed
+ *        one per byte
+ *
+ * x0 occupies the top byte of the first word, so that comparing the words
+ * compares the exponent vectors lexicographically. A product whose
+ * exponent would exceed 255 throws std::overflow_error.
+ */
+struct monomial
+{
+    static constexpr std::size_t max_vars = 16;
+
+    std::array<std::uint64_t, 2> words {0, 0};
+
+    /*!
+     * @brief
+     *
+     * @param[in] i variable
+     * @param[in] e exponent
+     * @return x_i^e
+     */
+    static constexpr auto var(std::size_t i, std::uint64_t e = 1)
+        -> monomial
+    {
+        assert(i < max_vars && e < 256);
+        auto m = monomial {};
+        m.words[i / 8] = e << (8 * (7 - i % 8));
+        return m;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i variable
+     * @return exponent of x_i
+     */
+    [[nodiscard]] constexpr auto exponent(std::size_t i) const -> unsigned
+    {
+        return unsigned(this->words[i / 8] >> (8 * (7 - i % 8))) & 0xFFU;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return total degree
+     */
+    [[nodiscard]] constexpr auto degree() const -> unsigned
+    {
+        auto d = 0U;
+        for (auto i = 0U; i != max_vars; ++i)
+        {
+            d += this->exponent(i);
+        }
+        return d;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] b
+     * @return whether this divides b
+     */
+    [[nodiscard]] constexpr auto divides(const monomial& b) const -> bool
+    {
+        for (auto i = 0U; i != max_vars; ++i)
+        {
+            if (this->exponent(i) > b.exponent(i))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] a
+     * @param[in] b
+     * @return greatest common divisor, i.e. the minimum exponents
+     */
+    static constexpr auto gcd(const monomial& a, const monomial& b)
+        -> monomial
+    {
+        auto m = monomial {};
+        for (auto i = 0U; i != max_vars; ++i)
+        {
+            m.words[i / 8] |=
+                var(i, std::min(a.exponent(i), b.exponent(i))).words[i / 8];
+        }
+        return m;
+    }
+
+    constexpr auto operator*=(const monomial& b) -> monomial&
+    {
+        // no exponent may overflow into its neighbour: no carry out of
+        // the top bit of any byte
+        const auto carries = [](auto a, auto c) {
+            const auto s = a + c;
+            return ((a & c) | ((a | c) & ~s)) & 0x8080808080808080ULL;
+        };
+        if (carries(this->words[0], b.words[0]) != 0 ||
+            carries(this->words[1], b.words[1]) != 0)
+        {
+            throw std::overflow_error("monomial: exponent exceeds 255");
+        }
+        this->words[0] += b.words[0];
+        this->words[1] += b.words[1];
+        return *this;
+    }
+
+    constexpr auto operator/=(const monomial& b) -> monomial&
+    {
+        assert(b.divides(*this));
+        this->words[0] -= b.words[0];
+        this->words[1] -= b.words[1];
+        return *this;
+    }
+
+    friend constexpr auto operator*(monomial a, const monomial& b)
+        -> monomial
+    {
+        return a *= b;
+    }
+
+    friend constexpr auto operator/(monomial a, const monomial& b)
+        -> monomial
+    {
+        return a /= b;
+    }
+
+    friend constexpr auto operator==(const monomial& a, const monomial& b)
+        -> bool = default;
+
+    friend constexpr auto operator<=>(const monomial& a, const monomial& b)
+        -> std::strong_ordering = default;
+};
+
+/**
+ * @brief Hash of a monomial
+ *
+ */
+struct monomial_hash
+{
+    auto operator()(const monomial& m) const noexcept -> std::size_t
+    {
+        auto h = m.words[0] * 0x9E3779B97F4A7C15ULL;
+        h ^= (m.words[1] + (h << 6U) + (h >> 2U)) * 0xBF58476D1CE4E5B9ULL;
+        return std::size_t(h ^ (h >> 31U));
+    }
+};
+
+/**
+ * @brief Sparse multivariate polynomial with cpp_int coefficients
+ *
+ * The terms are kept sorted by decreasing monomial in lex order, without
+ * zero coefficients, so equal polynomials have equal representations.
+ *
+ * To serve as the Z of Fraction<Z>, poly also models Integral:
+ *  - a / b and a % b are the quotient and remainder of multivariate
+ *    division by the leading term of b (exact when b divides a);
+ *  - a < b if the leading coefficient of a - b is negative, which orders
+ *    the ring compatibly with + and *;
+ *  - gcd(a, b) is the greatest common divisor of all the terms of a and
+ *    b, i.e. the integer content times the monomial gcd. It is a common
+ *    divisor but not in general the polynomial gcd, so Fraction<poly>
+ *    removes common contents and powers of variables only.
+ */
+class poly
+{
+  public:
+    using coeff_type = boost::multiprecision::cpp_int;
+    using term_type = std::pair<monomial, coeff_type>;
+
+  private:
+    std::vector<term_type> _terms;
+
+    template <typename Expr>
+    static auto sign(const Expr& c) -> std::strong_ordering
+    {
+        const auto s = coeff_type(c).sign();
+        return s < 0 ? std::strong_ordering::less
+                     : (s > 0 ? std::strong_ordering::greater
+                              : std::strong_ordering::equal);
+    }
+
+    // a x m, which keeps the order of terms
+    static auto mul_term(const poly& a, const monomial& m,
+        const coeff_type& c) -> poly
+    {
+        auto res = poly {};
+        res._terms.reserve(a._terms.size());
+        for (const auto& [ma, ca] : a._terms)
+        {
+            res._terms.emplace_back(ma * m, ca * c);
+        }
+        return res;
+    }
+
+    // a + s b, s = 1 or -1
+    static auto add(const poly& a, const poly& b, int s) -> poly
+    {
+        auto res = poly {};
+        res._terms.reserve(a._terms.size() + b._terms.size());
+        auto i = a._terms.begin();
+        auto j = b._terms.begin();
+        while (i != a._terms.end() || j != b._terms.end())
+        {
+            if (j == b._terms.end() ||
+                (i != a._terms.end() && i->first > j->first))
+            {
+                res._terms.push_back(*i++);
+            }
+            else if (i == a._terms.end() || j->first > i->first)
+            {
+                res._terms.emplace_back(j->first, s * j->second);
+                ++j;
+            }
+            else
+            {
+                auto c = coeff_type(i->second);
+                if (s > 0)
+                {
+                    c += j->second;
+                }
+                else
+                {
+                    c -= j->second;
+                }
+                if (c != 0)
+                {
+                    res._terms.emplace_back(i->first, std::move(c));
+                }
+                ++i;
+                ++j;
+            }
+        }
+        return res;
+    }
+
+    // hashed accumulation of the products of all pairs of terms
+    static auto mul(const poly& a, const poly& b) -> poly
+    {
+        if (a._terms.empty() || b._terms.empty())
+        {
+            return poly {};
+        }
+        if (b._terms.size() == 1)
+        {
+            return mul_term(a, b._terms[0].first, b._terms[0].second);
+        }
+        if (a._terms.size() == 1)
+        {
+            return mul_term(b, a._terms[0].first, a._terms[0].second);
+        }
+
+        struct scratch_t
+        {
+            std::unordered_map<monomial, std::size_t, monomial_hash> index;
+            std::vector<term_type> acc;
+            coeff_type prod;
+        };
+        // reused by all products on this thread, so that the table, the
+        // term buffer and the coefficients keep their storage
+        thread_local auto scratch = scratch_t {};
+        auto& [index, acc, prod] = scratch;
+        index.clear();
+        index.reserve(a._terms.size() * b._terms.size());
+        auto n = std::size_t(0);
+        for (const auto& [ma, ca] : a._terms)
+        {
+            for (const auto& [mb, cb] : b._terms)
+            {
+                const auto [it, fresh] = index.try_emplace(ma * mb, n);
+                if (fresh)
+                {
+                    if (n == acc.size())
+                    {
+                        acc.emplace_back();
+                    }
+                    acc[n].first = it->first;
+                    boost::multiprecision::multiply(acc[n].second, ca, cb);
+                    ++n;
+                }
+                else
+                {
+                    boost::multiprecision::multiply(prod, ca, cb);
+                    acc[it->second].second += prod;
+                }
+            }
+        }
+
+        auto res = poly {};
+        res._terms.reserve(n);
+        for (auto k = std::size_t(0); k != n; ++k)
+        {
+            if (acc[k].second != 0)
+            {
+                res._terms.emplace_back(acc[k].first, acc[k].second);
+            }
+        }
+        std::sort(res._terms.begin(), res._terms.end(),
+            [](const auto& s, const auto& t) { return s.first > t.first; });
+        return res;
+    }
+
+    // quotient and remainder of division by the leading term of b
+    static auto divmod(const poly& a, const poly& b) -> std::pair<poly, poly>
+    {
+        assert(!b._terms.empty());
+        const auto& [mb, cb] = b._terms.front();
+        auto quot = poly {};
+        auto rem = poly {};
+        auto r = a;
+        while (!r._terms.empty())
+        {
+            const auto& [mr, cr] = r._terms.front();
+            if (mb.divides(mr) && cr % cb == 0)
+            {
+                const auto m = mr / mb;
+                const auto c = coeff_type(cr / cb);
+                quot._terms.emplace_back(m, c);
+                r = add(r, mul_term(b, m, c), -1);
+            }
+            else
+            {
+                rem._terms.push_back(r._terms.front());
+                r._terms.erase(r._terms.begin());
+            }
+        }
+        return {std::move(quot), std::move(rem)};
+    }
+
+  public:
+    /*!
+     * @brief Construct zero
+     *
+     */
+    poly() = default;
+
+    /*!
+     * @brief Construct a constant
+     *
+     * @param[in] c
+     */
+    poly(coeff_type c) // NOLINT(google-explicit-constructor)
+    {
+        if (c != 0)
+        {
+            this->_terms.emplace_back(monomial {}, std::move(c));
+        }
+    }
+
+    /*!
+     * @brief Construct a constant
+     *
+     * @param[in] c
+     */
+    template <std::integral T>
+    poly(T c) // NOLINT(google-explicit-constructor)
+        : poly {coeff_type(c)}
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i
+     * @return the variable x_i
+     */
+    static auto var(std::size_t i) -> poly
+    {
+        auto res = poly {};
+        res._terms.emplace_back(monomial::var(i), 1);
+        return res;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return the terms, by decreasing monomial
+     */
+    [[nodiscard]] auto terms() const -> std::span<const term_type>
+    {
+        return this->_terms;
+    }
+
+    /*!
+     * @brief
+     *
+     * @return total degree, 0 for the zero polynomial
+     */
+    [[nodiscard]] auto degree() const -> unsigned
+    {
+        auto d = 0U;
+        for (const auto& t : this->_terms)
+        {
+            d = std::max(d, t.first.degree());
+        }
+        return d;
+    }
+
+    auto operator+=(const poly& b) -> poly&
+    {
+        return *this = add(*this, b, 1);
+    }
+
+    auto operator-=(const poly& b) -> poly&
+    {
+        return *this = add(*this, b, -1);
+    }
+
+    auto operator*=(const poly& b) -> poly&
+    {
+        return *this = mul(*this, b);
+    }
+
+    auto operator/=(const poly& b) -> poly&
+    {
+        return *this = divmod(*this, b).first;
+    }
+
+    auto operator%=(const poly& b) -> poly&
+    {
+        return *this = divmod(*this, b).second;
+    }
+
+    auto operator-() const -> poly
+    {
+        auto res = *this;
+        for (auto& t : res._terms)
+        {
+            t.second = -t.second;
+        }
+        return res;
+    }
+
+    friend auto operator+(const poly& a, const poly& b) -> poly
+    {
+        return add(a, b, 1);
+    }
+
+    friend auto operator-(const poly& a, const poly& b) -> poly
+    {
+        return add(a, b, -1);
+    }
+
+    friend auto operator*(const poly& a, const poly& b) -> poly
+    {
+        return mul(a, b);
+    }
+
+    friend auto operator/(const poly& a, const poly& b) -> poly
+    {
+        return divmod(a, b).first;
+    }
+
+    friend auto operator%(const poly& a, const poly& b) -> poly
+    {
+        return divmod(a, b).second;
+    }
+
+    friend auto operator==(const poly& a, const poly& b) -> bool
+    {
+        return a._terms == b._terms;
+    }
+
+    /*!
+     * @brief sign of the leading coefficient of a - b
+     *
+     */
+    friend auto operator<=>(const poly& a, const poly& b)
+        -> std::strong_ordering
+    {
+        auto i = a._terms.begin();
+        auto j = b._terms.begin();
+        for (; i != a._terms.end() && j != b._terms.end(); ++i, ++j)
+        {
+            if (i->first != j->first)
+            {
+                return i->first > j->first ? sign(i->second)
+                                           : 0 <=> sign(j->second);
+            }
+            if (i->second != j->second)
+            {
+                return sign(i->second - j->second);
+            }
+        }
+        if (i != a._terms.end())
+        {
+            return sign(i->second);
+        }
+        if (j != b._terms.end())
+        {
+            return 0 <=> sign(j->second);
+        }
+        return std::strong_ordering::equal;
+    }
+
+    /*!
+     * @brief Greatest common divisor of all the terms of a and b
+     *
+     * @param[in] a
+     * @param[in] b
+     * @return integer content times monomial gcd, with positive coefficient
+     */
+    friend auto gcd(const poly& a, const poly& b) -> poly
+    {
+        if (a._terms.empty() && b._terms.empty())
+        {
+            return poly {};
+        }
+        const auto& first =
+            a._terms.empty() ? b._terms.front() : a._terms.front();
+        auto m = first.first;
+        auto c = coeff_type(boost::multiprecision::abs(first.second));
+        for (const auto* p : {&a, &b})
+        {
+            for (const auto& [mt, ct] : p->_terms)
+            {
+                m = monomial::gcd(m, mt);
+                if (c != 1)
+                {
+                    c = boost::multiprecision::gcd(c, ct);
+                }
+            }
+        }
+        auto res = poly {};
+        res._terms.emplace_back(m, std::move(c));
+        return res;
+    }
+
+    template <typename Stream>
+    friend auto operator<<(Stream& os, const poly& p) -> Stream&
+    {
+        if (p._terms.empty())
+        {
+            os << '0';
+        }
+        auto first = true;
+        for (const auto& [m, c] : p._terms)
+        {
+            os << (c < 0 ? (first ? "-" : " - ") : (first ? "" : " + "));
+            const auto a = coeff_type(boost::multiprecision::abs(c));
+            const auto constant = (m == monomial {});
+            if (a != 1 || constant)
+            {
+                os << a;
+            }
+            auto sep = (a != 1 || constant) ? "*" : "";
+            for (auto i = 0U; i != monomial::max_vars; ++i)
+            {
+                if (const auto e = m.exponent(i); e != 0)
+                {
+                    os << sep << 'x' << i;
+                    if (e != 1)
+                    {
+                        os << '^' << e;
+                    }
+                    sep = "*";
+                }
+            }
+            first = false;
+        }
+        return os;
+    }
+};
+
+} // namespace fun
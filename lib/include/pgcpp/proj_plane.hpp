@@ -50,6 +50,9 @@ constexpr auto coincident(
 template <typename P>
 using Triple = std::tuple<P, P, P>;
 
+template <typename P>
+using Quadruple = std::tuple<P, P, P, P>;
+
 /*!
  * @brief
  *
@@ -186,6 +189,26 @@ class involution
     {
     }
 
+    /*!
+     * @brief mirror (axis) of the involution
+     *
+     * @return const L&
+     */
+    [[nodiscard]] constexpr auto mirror() const -> const L&
+    {
+        return this->_m;
+    }
+
+    /*!
+     * @brief center of the involution
+     *
+     * @return const P&
+     */
+    [[nodiscard]] constexpr auto center() const -> const P&
+    {
+        return this->_o;
+    }
+
     /*!
      * @brief
      *
@@ -252,16 +275,17 @@ class involution_generic
 };
 
 /*!
- * @brief Check Pappus Theorem
+ * @brief Whether Pappus Theorem holds for two collinear triples
  *
  * @tparam P
- * @tparam L
- * @param[in] co1
- * @param[in] co2
+ * @param[in] co1 three collinear points
+ * @param[in] co2 three collinear points
+ * @return true if the three cross joins meet in collinear points
+ * @return false otherwise
  */
 template <Projective_plane_prim2 P>
-void check_pappus(const Triple<P>& co1, const Triple<P>& co2)
-
+constexpr auto pappus_holds(const Triple<P>& co1, const Triple<P>& co2)
+    -> bool
 {
     const auto& [A, B, C] = co1;
     const auto& [D, E, F] = co2;
@@ -269,23 +293,53 @@ void check_pappus(const Triple<P>& co1, const Triple<P>& co2)
     const auto G = (A * E) * (B * D);
     const auto H = (A * F) * (C * D);
     const auto I = (B * F) * (C * E);
-    assert(coincident(G, H, I));
+    return coincident(G * H, I);
 }
 
 /*!
- * @brief
+ * @brief Check Pappus Theorem
+ *
+ * @tparam P
+ * @tparam L
+ * @param[in] co1
+ * @param[in] co2
+ */
+template <Projective_plane_prim2 P>
+void check_pappus(const Triple<P>& co1, const Triple<P>& co2)
+{
+    assert(pappus_holds(co1, co2));
+}
+
+/*!
+ * @brief Whether Desargues Theorem holds for two triangles
  *
  * @param[in] tri1
  * @param[in] tri2
+ * @return true if the triangles are either perspective from both a point
+ *         and a line, or from neither
+ * @return false otherwise
  */
 template <Projective_plane_prim2 P>
-void check_desargue(const Triple<P>& tri1, const Triple<P>& tri2)
+constexpr auto desargue_holds(const Triple<P>& tri1, const Triple<P>& tri2)
+    -> bool
 {
     const auto trid1 = tri_dual(tri1);
     const auto trid2 = tri_dual(tri2);
     const auto b1 = persp(tri1, tri2);
     const auto b2 = persp(trid1, trid2);
-    assert((b1 && b2) || (!b1 && !b2));
+    return b1 == b2;
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] tri1
+ * @param[in] tri2
+ */
+template <Projective_plane_prim2 P>
+void check_desargue(const Triple<P>& tri1, const Triple<P>& tri2)
+{
+    assert(desargue_holds(tri1, tri2));
 }
 
 } // namespace fun
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "fractions.hpp"
+#include "parallel.hpp"
 #include "proj_plane.hpp"
+#include <cassert>
+#include <span>
+#include <utility>
 
 /*! @file include/proj_plane.hpp
  *  This is a C++ Library header.
@@ -126,4 +130,157 @@ constexpr auto R1(const P& A, const P& B, const P& C, const P& D)
     return ratio_ratio(cross1(A, C), cross1(A, D), cross1(B, C), cross1(B, D));
 }
 
+/*!
+ * @brief Unreduced form (a * d, b * c) of ratio_ratio(a, b, c, d)
+ *
+ * @tparam K
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @param[in] d
+ * @return numerator and denominator
+ */
+template <ring K>
+constexpr auto ratio_pair(const K& a, const K& b, const K& c, const K& d)
+    -> std::pair<K, K>
+{
+    return {K(a * d), K(b * c)};
+}
+
+/*!
+ * @brief Unreduced cross ratio R(A,B;l,m) as a (numerator, denominator) pair
+ *
+ * @param[in] A
+ * @param[in] B
+ * @param[in] l
+ * @param[in] m
+ * @return numerator and denominator
+ */
+template <typename P, typename L>
+requires Projective_plane<P, L>
+constexpr auto x_ratio_pair(const P& A, const P& B, const L& l, const L& m)
+{
+    return ratio_pair(A.dot(l), A.dot(m), B.dot(l), B.dot(m));
+}
+
+/*!
+ * @brief Unreduced cross ratio R(A,B;C,D) as a (numerator, denominator) pair
+ *
+ * @param[in] A
+ * @param[in] B
+ * @param[in] C
+ * @param[in] D
+ * @return numerator and denominator
+ */
+template <Projective_plane_coord2 P>
+constexpr auto R_pair(const P& A, const P& B, const P& C, const P& D)
+{
+    using K = Value_type<P>;
+    if (cross0(A, B) != K(0))
+    { // Project points to yz-plane
+        return ratio_pair(
+            cross0(A, C), cross0(A, D), cross0(B, C), cross0(B, D));
+    }
+    // Project points to xz-plane
+    return ratio_pair(cross1(A, C), cross1(A, D), cross1(B, C), cross1(B, D));
+}
+
+/*!
+ * @brief Unreduced cross ratio R(A,B;C,D) as a (numerator, denominator) pair
+ *
+ * @param[in] A
+ * @param[in] B
+ * @param[in] C
+ * @param[in] D
+ * @return numerator and denominator
+ */
+template <Projective_plane2 P>
+constexpr auto R_pair(const P& A, const P& B, const P& C, const P& D)
+{
+    const auto O = (C * D).aux();
+    return x_ratio_pair(A, B, O * C, O * D);
+}
+
+/*!
+ * @brief Compare two unreduced ratios for equality by cross-multiplication
+ *
+ * @tparam K
+ * @param[in] r1 (numerator, denominator)
+ * @param[in] r2 (numerator, denominator)
+ * @return true if r1.first / r1.second == r2.first / r2.second
+ */
+template <ring K>
+constexpr auto cross_ratio_equal(
+    const std::pair<K, K>& r1, const std::pair<K, K>& r2) -> bool
+{
+    return r1.first * r2.second == r2.first * r1.second;
+}
+
+/*!
+ * @brief Compare two unreduced ratios by cross-multiplication
+ *
+ * @tparam K
+ * @param[in] r1 (numerator, denominator)
+ * @param[in] r2 (numerator, denominator)
+ * @return true if r1.first / r1.second < r2.first / r2.second
+ */
+template <ordered_ring K>
+constexpr auto cross_ratio_less(
+    const std::pair<K, K>& r1, const std::pair<K, K>& r2) -> bool
+{
+    const auto lhs = K(r1.first * r2.second);
+    const auto rhs = K(r2.first * r1.second);
+    if ((r1.second < K(0)) != (r2.second < K(0)))
+    {
+        return rhs < lhs;
+    }
+    return lhs < rhs;
+}
+
+/*!
+ * @brief Whether R(A,B;C,D) == R(E,F;G,H), without any division or gcd
+ *
+ * @return true
+ * @return false
+ */
+template <Projective_plane2 P>
+constexpr auto cross_ratio_equal(const P& A, const P& B, const P& C,
+    const P& D, const P& E, const P& F, const P& G, const P& H) -> bool
+{
+    return cross_ratio_equal(R_pair(A, B, C, D), R_pair(E, F, G, H));
+}
+
+/*!
+ * @brief Whether R(A,B;C,D) < R(E,F;G,H), without any division or gcd
+ *
+ * @return true
+ * @return false
+ */
+template <Projective_plane2 P>
+constexpr auto cross_ratio_less(const P& A, const P& B, const P& C,
+    const P& D, const P& E, const P& F, const P& G, const P& H) -> bool
+{
+    return cross_ratio_less(R_pair(A, B, C, D), R_pair(E, F, G, H));
+}
+
+/*!
+ * @brief Batched unreduced cross ratios
+ *
+ * @param[in] quads point 4-tuples (A, B, C, D)
+ * @param[out] out R(A,B;C,D) as (numerator, denominator), same size as quads
+ */
+template <Projective_plane2 P>
+void R_pair(std::span<const Quadruple<P>> quads,
+    std::span<std::pair<Value_type<P>, Value_type<P>>> out)
+{
+    assert(quads.size() == out.size());
+    parallel_for(quads.size(), [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i != last; ++i)
+        {
+            const auto& [A, B, C, D] = quads[i];
+            out[i] = R_pair(A, B, C, D);
+        }
+    });
+}
+
 } // namespace fun
@@ -0,0 +1,340 @@
+#pragma once
+
+#include "fractions.hpp"
+#include "parallel.hpp"
+#include "pg_common.hpp"
+#include "pg_point.hpp"
+#include "proj_plane.hpp"
+#include <cassert>
+#include <optional>
+#include <span>
+
+/*! @file include/projectivity.hpp
+ *  This is a C++ Library header.
+ */
+
+namespace fun
+{
+
+namespace detail
+{
+    // H = sum_i w_i q_i l_i^T where l_i are the sides of src: with
+    // l1 = p2 * p3 etc., H p_i is a multiple of q_i and the weights w_i
+    // are chosen such that H p4 is a multiple of q4. No three points of
+    // either quadruple may be collinear.
+    template <typename P>
+    constexpr auto frame_matrix(const Quadruple<P>& src,
+        const Quadruple<P>& dst) -> Mat3<Value_type<P>>
+    {
+        using K = Value_type<P>;
+        const auto& [p1, p2, p3, p4] = src;
+        const auto& [q1, q2, q3, q4] = dst;
+        const auto l1 = p2 * p3;
+        const auto l2 = p1 * p3;
+        const auto l3 = p1 * p2;
+        const auto m1 = q2 * q3;
+        const auto m2 = q1 * q3;
+        const auto m3 = q1 * q2;
+        // p4 = sum lda_i p_i, q4 = sum mu_i q_i (up to a common scalar)
+        const auto lda1 = p4.dot(l1);
+        const auto lda2 = -p4.dot(l2);
+        const auto lda3 = p4.dot(l3);
+        const auto mu1 = q4.dot(m1);
+        const auto mu2 = -q4.dot(m2);
+        const auto mu3 = q4.dot(m3);
+        assert(lda1 != K(0) && lda2 != K(0) && lda3 != K(0));
+        assert(mu1 != K(0) && mu2 != K(0) && mu3 != K(0));
+
+        const auto w1 = mu1 * lda2 * lda3;
+        const auto w2 = -(mu2 * lda1 * lda3);
+        const auto w3 = mu3 * lda1 * lda2;
+        auto H = Mat3<K> {};
+        for (auto i = 0U; i != 3; ++i)
+        {
+            const auto a1 = w1 * q1[i];
+            const auto a2 = w2 * q2[i];
+            const auto a3 = w3 * q3[i];
+            for (auto j = 0U; j != 3; ++j)
+            {
+                H[i][j] = a1 * l1[j] + a2 * l2[j] + a3 * l3[j];
+            }
+        }
+        return H;
+    }
+} // namespace detail
+
+/**
+ * @brief Projectivity (collineation) given by a 3x3 matrix H
+ *
+ * Points are mapped by p -> H p, lines by l -> adj(H)^T l, so that
+ * incidence is preserved. Matrices are only defined up to a scalar.
+ *
+ * @tparam P Point
+ * @tparam L Line
+ */
+template <typename P, typename L = typename P::dual>
+requires Projective_plane_coord<P, L>
+class projectivity
+{
+    using K = Value_type<P>;
+
+  public:
+    using matrix_t = Mat3<K>;
+
+  private:
+    matrix_t _mat;
+    matrix_t _adj; // cached for the line action and the inverse
+
+  public:
+    /*!
+     * @brief Construct a new projectivity object
+     *
+     * @param[in] mat matrix H (row major)
+     */
+    constexpr explicit projectivity(matrix_t mat)
+        : _mat {std::move(mat)}
+        , _adj {mat3_adj(_mat)}
+    {
+    }
+
+    /*!
+     * @brief Construct from an involution, H = c I - 2 o m^T with c = m.o
+     *
+     * @param[in] tau
+     */
+    constexpr explicit projectivity(const involution<P, L>& tau)
+        : projectivity {involution_matrix(tau.mirror(), tau.center())}
+    {
+    }
+
+    /*!
+     * @brief Construct from a dual involution, such as those returned by
+     *        ck::reflect(line)
+     *
+     * @param[in] tau
+     */
+    constexpr explicit projectivity(const involution<L, P>& tau)
+        : projectivity {involution_matrix(tau.center(), tau.mirror())}
+    {
+    }
+
+    /*!
+     * @brief Construct the projectivity mapping src[i] to dst[i]
+     *
+     * No three points of either quadruple may be collinear.
+     *
+     * @param[in] src
+     * @param[in] dst
+     */
+    constexpr projectivity(const Quadruple<P>& src, const Quadruple<P>& dst)
+        : projectivity {detail::frame_matrix(src, dst)}
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @return const matrix_t&
+     */
+    [[nodiscard]] constexpr auto matrix() const -> const matrix_t&
+    {
+        return this->_mat;
+    }
+
+    /*!
+     * @brief Image of a point
+     *
+     * @param[in] p
+     * @return P
+     */
+    constexpr auto operator()(const P& p) const -> P
+    {
+        return P {mat3_vec(this->_mat, p)};
+    }
+
+    /*!
+     * @brief Image of a line
+     *
+     * @param[in] l
+     * @return L
+     */
+    constexpr auto operator()(const L& l) const -> L
+    {
+        return L {mat3_tvec(this->_adj, l)};
+    }
+
+    /*!
+     * @brief Composition, (this->compose(g))(p) == (*this)(g(p))
+     *
+     * @param[in] g
+     * @return projectivity
+     */
+    [[nodiscard]] constexpr auto compose(const projectivity& g) const
+        -> projectivity
+    {
+        return projectivity {mat3_mul(this->_mat, g._mat)};
+    }
+
+    /*!
+     * @brief Inverse (exact, via the adjugate)
+     *
+     * @return projectivity
+     */
+    [[nodiscard]] constexpr auto inverse() const -> projectivity
+    {
+        return projectivity {this->_adj};
+    }
+
+    /*!
+     * @brief Apply to a batch of points
+     *
+     * @param[in] in
+     * @param[out] out must have the same size as in
+     */
+    void transform(std::span<const P> in, std::span<P> out) const
+    {
+        assert(in.size() == out.size());
+        parallel_for(in.size(), [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                out[i] = P {mat3_vec(this->_mat, in[i])};
+            }
+        });
+    }
+
+    /*!
+     * @brief Apply to a batch of lines
+     *
+     * @param[in] in
+     * @param[out] out must have the same size as in
+     */
+    void transform(std::span<const L> in, std::span<L> out) const
+    {
+        assert(in.size() == out.size());
+        parallel_for(in.size(), [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                out[i] = L {mat3_tvec(this->_adj, in[i])};
+            }
+        });
+    }
+
+  private:
+    static constexpr auto involution_matrix(const L& m, const P& o)
+        -> matrix_t
+    {
+        const auto c = m.dot(o);
+        auto H = matrix_t {};
+        for (auto i = 0U; i != 3; ++i)
+        {
+            for (auto j = 0U; j != 3; ++j)
+            {
+                H[i][j] = K(-2) * o[i] * m[j];
+            }
+            H[i][i] += c;
+        }
+        return H;
+    }
+};
+
+/*!
+ * @brief Return whether three of the four points are collinear
+ *
+ * @param[in] quad
+ * @return true
+ * @return false
+ */
+template <Projective_plane_prim2 P>
+constexpr auto has_collinear_triple(const Quadruple<P>& quad) -> bool
+{
+    const auto& [p1, p2, p3, p4] = quad;
+    const auto l12 = p1 * p2;
+    return coincident(l12, p3) || coincident(l12, p4) ||
+        coincident(p1 * p3, p4) || coincident(p2 * p3, p4);
+}
+
+/*!
+ * @brief Exact projectivity mapping src[i] to dst[i] over an integral ring
+ *
+ * The matrix is reduced by the gcd of its entries.
+ *
+ * @param[in] src
+ * @param[in] dst
+ * @return the projectivity, or std::nullopt if three points of src or of dst
+ *         are collinear
+ */
+template <typename P, typename L = typename P::dual>
+requires Projective_plane_coord<P, L> && Integral<Value_type<P>>
+auto fit_projectivity(const Quadruple<P>& src, const Quadruple<P>& dst)
+    -> std::optional<projectivity<P, L>>
+{
+    if (has_collinear_triple(src) || has_collinear_triple(dst))
+    {
+        return std::nullopt;
+    }
+    auto H = detail::frame_matrix(src, dst);
+    reduce_mat3(H);
+    return projectivity<P, L> {std::move(H)};
+}
+
+/*!
+ * @brief Clear the denominators of a point with rational coordinates
+ *
+ * @param[in] p
+ * @return pg_point<Z>
+ */
+template <Integral Z>
+auto clear_denominators(const pg_point<Fraction<Z>>& p) -> pg_point<Z>
+{
+    const auto d = lcm(lcm(p[0].den(), p[1].den()), p[2].den());
+    return pg_point<Z> {p[0].num() * (d / p[0].den()),
+        p[1].num() * (d / p[1].den()), p[2].num() * (d / p[2].den())};
+}
+
+/*!
+ * @brief Exact projectivity from points with rational coordinates
+ *
+ * @param[in] src
+ * @param[in] dst
+ * @return projectivity over the integers, or std::nullopt if degenerate
+ */
+template <Integral Z>
+auto fit_projectivity(const Quadruple<pg_point<Fraction<Z>>>& src,
+    const Quadruple<pg_point<Fraction<Z>>>& dst)
+    -> std::optional<projectivity<pg_point<Z>>>
+{
+    const auto to_int = [](const auto& quad) {
+        const auto& [p1, p2, p3, p4] = quad;
+        return Quadruple<pg_point<Z>> {clear_denominators(p1),
+            clear_denominators(p2), clear_denominators(p3),
+            clear_denominators(p4)};
+    };
+    return fit_projectivity(to_int(src), to_int(dst));
+}
+
+/*!
+ * @brief Fit many independent projectivities in parallel
+ *
+ * @param[in] src
+ * @param[in] dst
+ * @param[out] out out[i] maps src[i] to dst[i] (std::nullopt if degenerate)
+ */
+template <typename P, typename L = typename P::dual>
+requires Projective_plane_coord<P, L> && Integral<Value_type<P>>
+void fit_projectivity(std::span<const Quadruple<P>> src,
+    std::span<const Quadruple<P>> dst,
+    std::span<std::optional<projectivity<P, L>>> out)
+{
+    assert(src.size() == dst.size() && src.size() == out.size());
+    parallel_for(
+        src.size(),
+        [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                out[i] = fit_projectivity<P, L>(src[i], dst[i]);
+            }
+        },
+        64);
+}
+
+} // namespace fun
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "parallel.hpp"
+#include "pg_common.hpp"
+#include "point_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+
+/*! @file include/rescale.hpp
+ *  This is a C++ Library header.
+ *
+ *  Exponent normalization of floating point homogeneous coordinates.
+ *  Every join or meet multiplies the magnitudes of the coordinates, so a
+ *  long chain of constructions in double ends in inf or in denormals. As
+ *  the coordinates are homogeneous, they may be multiplied by any power of
+ *  two after each step: this is exact and does not change the object.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Rescaling policy that leaves the coordinates alone
+ *
+ * The call is empty and inlined, so code written for a policy costs
+ * nothing when instantiated with no_rescale.
+ */
+struct no_rescale
+{
+    template <typename K>
+    constexpr void operator()(std::array<K, 3>& /* v */) const
+    {
+    }
+};
+
+/**
+ * @brief Rescaling policy that brings the largest coordinate into
+ *        [0.5, 1) by a power of two
+ *
+ * Zero and non-finite coordinates are left unchanged. A coordinate more
+ * than 2^1021 times smaller than the largest one may lose bits, as it
+ * would in any case when it takes part in a sum with the others.
+ */
+struct pow2_rescale
+{
+    template <std::floating_point K>
+    void operator()(std::array<K, 3>& v) const
+    {
+        using std::abs;
+        const auto m = std::max({abs(v[0]), abs(v[1]), abs(v[2])});
+        if (m == K(0) || !std::isfinite(m))
+        {
+            return;
+        }
+        auto e = 0;
+        std::frexp(m, &e);
+        for (auto& c : v)
+        {
+            c = std::ldexp(c, -e);
+        }
+    }
+};
+
+/*!
+ * @brief
+ *
+ * @tparam Policy
+ * @tparam P point or line
+ * @param[in] p
+ * @return p with its coordinates rescaled by Policy
+ */
+template <typename Policy = pow2_rescale, typename P>
+auto rescaled(const P& p) -> P
+{
+    auto res = P {p};
+    Policy {}(res);
+    return res;
+}
+
+/*!
+ * @brief Wrap a construction so that its result is rescaled
+ *
+ * e.g. rescaling([](const auto& a, const auto& b) { return a * b; }).
+ *
+ * @tparam Policy
+ * @tparam Fn
+ * @param[in] func callable returning a point or a line
+ * @return callable with the same arguments as func
+ */
+template <typename Policy = pow2_rescale, typename Fn>
+auto rescaling(Fn func)
+{
+    return [func](const auto&... args) {
+        auto res = func(args...);
+        Policy {}(res);
+        return res;
+    };
+}
+
+/*!
+ * @brief Rescale a batch of points (or lines) in place, in parallel
+ *
+ * @tparam Policy
+ * @tparam K
+ * @param[in,out] batch
+ */
+template <typename Policy = pow2_rescale, typename K>
+void rescale(point_batch<K>& batch)
+{
+    parallel_for(batch.size(), [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i != last; ++i)
+        {
+            auto v = std::array<K, 3> {batch.x[i], batch.y[i], batch.z[i]};
+            Policy {}(v);
+            batch.x[i] = v[0];
+            batch.y[i] = v[1];
+            batch.z[i] = v[2];
+        }
+    });
+}
+
+/*!
+ * @brief Pairwise joins of points (or meets of lines) of two batches,
+ *        rescaled by Policy, in parallel
+ *
+ * @tparam Policy
+ * @tparam K
+ * @param[in] a
+ * @param[in] b of the same size as a
+ * @return the batch of a[i] * b[i]
+ */
+template <typename Policy = pow2_rescale, typename K>
+auto rescaled_join_all(const point_batch<K>& a, const point_batch<K>& b)
+    -> point_batch<K>
+{
+    assert(a.size() == b.size());
+    auto res = point_batch<K> {};
+    res.resize(a.size());
+    parallel_for(a.size(), [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i != last; ++i)
+        {
+            const auto v = std::array<K, 3> {a.x[i], a.y[i], a.z[i]};
+            const auto w = std::array<K, 3> {b.x[i], b.y[i], b.z[i]};
+            auto u = cross(v, w);
+            Policy {}(u);
+            res.x[i] = u[0];
+            res.y[i] = u[1];
+            res.z[i] = u[2];
+        }
+    });
+    return res;
+}
+
+} // namespace fun
@@ -0,0 +1,544 @@
+#pragma once
+
+#include "ck_plane.hpp" // import check_sine_law
+#include "euclid_plane_measure.hpp"
+#include "fractions.hpp"
+#include "parallel.hpp"
+#include "point_batch.hpp"
+#include "proj_plane.hpp"
+#include "tri_eval.hpp" // import ck_term, ck_measure
+#include <array>
+#include <cassert>
+#include <span>
+#include <vector>
+
+/*! @file include/tri_batch.hpp
+ *  This is a C++ Library header.
+ *
+ *  Batched triangle functions over column (structure-of-arrays) storage.
+ *  The Euclidean kernels only read and write contiguous columns of K, so
+ *  for builtin K the inner loops are plain arithmetic that the compiler can
+ *  vectorize; each batch is also split across threads with parallel_for.
+ */
+
+namespace fun
+{
+
+/*!
+ * @brief Three columns of results, one entry per triangle in each
+ *
+ * @tparam T
+ */
+template <typename T>
+using Columns3 = std::array<std::vector<T>, 3>;
+
+/**
+ * @brief n triangles stored as the columns of their three vertices
+ *
+ * vertex[i].x[t] is the x-coordinate of the vertex a_{i+1} of triangle t.
+ *
+ * @tparam K
+ */
+template <typename K>
+struct triangle_batch
+{
+    std::array<point_batch<K>, 3> vertex;
+
+    /*!
+     * @brief
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->vertex[0].size();
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] n
+     */
+    void reserve(std::size_t n)
+    {
+        for (auto& v : this->vertex)
+        {
+            v.reserve(n);
+        }
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] tri
+     */
+    template <typename P>
+    void push_back(const Triple<P>& tri)
+    {
+        const auto& [a1, a2, a3] = tri;
+        this->vertex[0].push_back(a1);
+        this->vertex[1].push_back(a2);
+        this->vertex[2].push_back(a3);
+    }
+
+    /*!
+     * @brief the t-th triangle
+     *
+     * @tparam P
+     * @param[in] t
+     * @return Triple<P>
+     */
+    template <typename P>
+    [[nodiscard]] auto get(std::size_t t) const -> Triple<P>
+    {
+        return {this->vertex[0].template get<P>(t),
+            this->vertex[1].template get<P>(t),
+            this->vertex[2].template get<P>(t)};
+    }
+};
+
+/*!
+ * @brief Build a triangle batch from an array of triangles
+ *
+ * @param[in] tris
+ * @return triangle_batch
+ */
+template <typename P>
+auto make_triangle_batch(std::span<const Triple<P>> tris)
+    -> triangle_batch<Value_type<P>>
+{
+    auto batch = triangle_batch<Value_type<P>> {};
+    batch.reserve(tris.size());
+    for (const auto& tri : tris)
+    {
+        batch.push_back(tri);
+    }
+    return batch;
+}
+
+namespace detail
+{
+    // num / den, as a Fraction over integral K
+    template <typename K>
+    inline auto batch_ratio(const K& num, const K& den)
+    {
+        if constexpr (Integral<K>)
+        {
+            return Fraction<K>(num, den);
+        }
+        else
+        {
+            return num / den;
+        }
+    }
+
+    template <typename K>
+    using batch_ratio_t =
+        decltype(batch_ratio(std::declval<K>(), std::declval<K>()));
+
+    // indices (j, k) of the two vertices other than i
+    constexpr std::array<std::array<std::size_t, 2>, 3> tri_others {
+        {{1, 2}, {0, 2}, {0, 1}}};
+} // namespace detail
+
+/*!
+ * @brief Euclidean quadrances of a batch of triangles
+ *
+ * Column i holds q_i, the quadrance opposite vertex a_{i+1}, as in
+ * tri_quadrance.
+ *
+ * @param[in] batch
+ * @return Columns3
+ */
+template <typename K>
+auto tri_quadrance(const triangle_batch<K>& batch)
+    -> Columns3<detail::batch_ratio_t<K>>
+{
+    using Q_t = detail::batch_ratio_t<K>;
+    const auto n = batch.size();
+    auto res = Columns3<Q_t> {};
+    for (auto i = 0U; i != 3; ++i)
+    {
+        res[i].resize(n);
+        const auto [j, k] = detail::tri_others[i];
+        const auto& aj = batch.vertex[j];
+        const auto& ak = batch.vertex[k];
+        auto* out = res[i].data();
+        parallel_for(n, [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                const auto c0 = K(aj.y[t] * ak.z[t] - ak.y[t] * aj.z[t]);
+                const auto c1 = K(aj.x[t] * ak.z[t] - ak.x[t] * aj.z[t]);
+                const auto zz = K(aj.z[t] * ak.z[t]);
+                out[t] =
+                    detail::batch_ratio(K(c0 * c0 + c1 * c1), K(zz * zz));
+            }
+        });
+    }
+    return res;
+}
+
+/*!
+ * @brief Sides of a batch of triangles
+ *
+ * Entry i is l_i = a_j * a_k, as in tri_dual.
+ *
+ * @param[in] batch
+ * @return std::array<point_batch<K>, 3>
+ */
+template <typename K>
+auto tri_dual(const triangle_batch<K>& batch) -> std::array<point_batch<K>, 3>
+{
+    const auto n = batch.size();
+    auto res = std::array<point_batch<K>, 3> {};
+    for (auto i = 0U; i != 3; ++i)
+    {
+        res[i].resize(n);
+        const auto [j, k] = detail::tri_others[i];
+        const auto& aj = batch.vertex[j];
+        const auto& ak = batch.vertex[k];
+        auto& l = res[i];
+        parallel_for(n, [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                l.x[t] = aj.y[t] * ak.z[t] - ak.y[t] * aj.z[t];
+                l.y[t] = ak.x[t] * aj.z[t] - aj.x[t] * ak.z[t];
+                l.z[t] = aj.x[t] * ak.y[t] - ak.x[t] * aj.y[t];
+            }
+        });
+    }
+    return res;
+}
+
+/*!
+ * @brief Euclidean spreads of a batch of triangles
+ *
+ * Column i holds the spread at vertex a_{i+1}, i.e. the same values as
+ * tri_spread(tri_dual(tri)).
+ *
+ * @param[in] batch
+ * @return Columns3
+ */
+template <typename K>
+auto tri_spread(const triangle_batch<K>& batch)
+    -> Columns3<detail::batch_ratio_t<K>>
+{
+    using S_t = detail::batch_ratio_t<K>;
+    const auto n = batch.size();
+    const auto sides = tri_dual(batch);
+    auto dd = Columns3<K> {};
+    for (auto i = 0U; i != 3; ++i)
+    {
+        dd[i].resize(n);
+        const auto& l = sides[i];
+        auto* out = dd[i].data();
+        for (auto t = 0U; t != n; ++t)
+        {
+            out[t] = l.x[t] * l.x[t] + l.y[t] * l.y[t];
+        }
+    }
+    auto res = Columns3<S_t> {};
+    for (auto i = 0U; i != 3; ++i)
+    {
+        res[i].resize(n);
+        const auto [j, k] = detail::tri_others[i];
+        const auto& lj = sides[j];
+        const auto& lk = sides[k];
+        const auto* dj = dd[j].data();
+        const auto* dk = dd[k].data();
+        auto* out = res[i].data();
+        parallel_for(n, [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                const auto c2 = K(lj.x[t] * lk.y[t] - lk.x[t] * lj.y[t]);
+                out[t] = detail::batch_ratio(K(c2 * c2), K(dj[t] * dk[t]));
+            }
+        });
+    }
+    return res;
+}
+
+/*!
+ * @brief Euclidean orthocenters of a batch of triangles
+ *
+ * @param[in] batch
+ * @return point_batch<K>
+ */
+template <typename K>
+auto orthocenter(const triangle_batch<K>& batch) -> point_batch<K>
+{
+    const auto n = batch.size();
+    const auto sides = tri_dual(batch);
+    auto res = point_batch<K> {};
+    res.resize(n);
+    const auto& a1 = batch.vertex[0];
+    const auto& a2 = batch.vertex[1];
+    const auto& l1 = sides[0];
+    const auto& l2 = sides[1];
+    parallel_for(n, [&](std::size_t first, std::size_t last) {
+        for (auto t = first; t != last; ++t)
+        {
+            // t_i = a_i * fB(l_i), fB(l) = (l[0], l[1], 0)
+            const auto t1x = K(-a1.z[t] * l1.y[t]);
+            const auto t1y = K(a1.z[t] * l1.x[t]);
+            const auto t1z = K(a1.x[t] * l1.y[t] - l1.x[t] * a1.y[t]);
+            const auto t2x = K(-a2.z[t] * l2.y[t]);
+            const auto t2y = K(a2.z[t] * l2.x[t]);
+            const auto t2z = K(a2.x[t] * l2.y[t] - l2.x[t] * a2.y[t]);
+            res.x[t] = t1y * t2z - t2y * t1z;
+            res.y[t] = t2x * t1z - t1x * t2z;
+            res.z[t] = t1x * t2y - t2x * t1y;
+        }
+    });
+    return res;
+}
+
+/*!
+ * @brief Euclidean altitudes of a batch of triangles
+ *
+ * Entry i is the altitude through a_{i+1}, the same line as
+ * std::get<i>(tri_altitude(tri)).
+ *
+ * @param[in] batch
+ * @return std::array<point_batch<K>, 3>
+ */
+template <typename K>
+auto tri_altitude(const triangle_batch<K>& batch)
+    -> std::array<point_batch<K>, 3>
+{
+    const auto n = batch.size();
+    const auto sides = tri_dual(batch);
+    auto res = std::array<point_batch<K>, 3> {};
+    for (auto i = 0U; i != 3; ++i)
+    {
+        res[i].resize(n);
+        const auto& a = batch.vertex[i];
+        const auto& l = sides[i];
+        auto& t_i = res[i];
+        parallel_for(n, [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                // t_i = a_i * fB(l_i), fB(l) = (l[0], l[1], 0)
+                t_i.x[t] = -a.z[t] * l.y[t];
+                t_i.y[t] = a.z[t] * l.x[t];
+                t_i.z[t] = a.x[t] * l.y[t] - l.x[t] * a.y[t];
+            }
+        });
+    }
+    return res;
+}
+
+/*!
+ * @brief Euclidean midpoints of a batch of triangles
+ *
+ * Entries are the midpoints of (a1 a2), (a2 a3), (a1 a3), as in
+ * tri_midpoint.
+ *
+ * @param[in] batch
+ * @return std::array<point_batch<K>, 3>
+ */
+template <typename K>
+auto tri_midpoint(const triangle_batch<K>& batch)
+    -> std::array<point_batch<K>, 3>
+{
+    constexpr std::array<std::array<std::size_t, 2>, 3> ends {
+        {{0, 1}, {1, 2}, {0, 2}}};
+    const auto n = batch.size();
+    auto res = std::array<point_batch<K>, 3> {};
+    for (auto i = 0U; i != 3; ++i)
+    {
+        res[i].resize(n);
+        const auto& a = batch.vertex[ends[i][0]];
+        const auto& b = batch.vertex[ends[i][1]];
+        auto& m = res[i];
+        parallel_for(n, [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                // m = plucker(b[2], a, a[2], b)
+                m.x[t] = b.z[t] * a.x[t] + a.z[t] * b.x[t];
+                m.y[t] = b.z[t] * a.y[t] + a.z[t] * b.y[t];
+                m.z[t] = K(2) * a.z[t] * b.z[t];
+            }
+        });
+    }
+    return res;
+}
+
+/*!
+ * @brief check sine law for a batch of triangles
+ *
+ * @param[in] Q quadrances
+ * @param[in] S spreads
+ * @return one entry per triangle, nonzero if the law holds
+ */
+template <typename Q_t>
+auto check_sine_law(const Columns3<Q_t>& Q, const Columns3<Q_t>& S)
+    -> std::vector<char>
+{
+    const auto n = Q[0].size();
+    assert(S[0].size() == n);
+    auto res = std::vector<char>(n);
+    parallel_for(n, [&](std::size_t first, std::size_t last) {
+        for (auto t = first; t != last; ++t)
+        {
+            res[t] = char((S[0][t] * Q[1][t] == S[1][t] * Q[0][t]) &&
+                (S[1][t] * Q[2][t] == S[2][t] * Q[1][t]));
+        }
+    });
+    return res;
+}
+
+/*!
+ * @brief Quadrances of a batch of triangles in a ck plane
+ *
+ * Column i holds the same values as std::get<i>(pl.tri_quadrance(tri)).
+ *
+ * @param[in] pl
+ * @param[in] batch
+ * @return Columns3
+ */
+template <typename Plane, typename K>
+auto tri_quadrance(const Plane& pl, const triangle_batch<K>& batch)
+{
+    using P = typename Plane::point_t;
+    using Q_t = decltype(pl.measure(std::declval<P>(), std::declval<P>()));
+    const auto n = batch.size();
+    auto res = Columns3<Q_t> {};
+    for (auto& col : res)
+    {
+        col.resize(n);
+    }
+    parallel_for(
+        n,
+        [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                const auto [a1, a2, a3] = batch.template get<P>(t);
+                const auto ta1 = ck_term<Plane, P>(pl, a1);
+                const auto ta2 = ck_term<Plane, P>(pl, a2);
+                const auto ta3 = ck_term<Plane, P>(pl, a3);
+                res[0][t] = ck_measure(pl, a2, ta2, a3, ta3, a2 * a3);
+                res[1][t] = ck_measure(pl, a1, ta1, a3, ta3, a1 * a3);
+                res[2][t] = ck_measure(pl, a1, ta1, a2, ta2, a1 * a2);
+            }
+        },
+        64);
+    return res;
+}
+
+/*!
+ * @brief Spreads of a batch of triangles in a ck plane
+ *
+ * Column i holds the same values as
+ * std::get<i>(pl.tri_spread(tri_dual(tri))).
+ *
+ * @param[in] pl
+ * @param[in] batch
+ * @return Columns3
+ */
+template <typename Plane, typename K>
+auto tri_spread(const Plane& pl, const triangle_batch<K>& batch)
+{
+    using P = typename Plane::point_t;
+    using L = typename Plane::line_t;
+    using S_t = decltype(pl.measure(std::declval<L>(), std::declval<L>()));
+    const auto n = batch.size();
+    auto res = Columns3<S_t> {};
+    for (auto& col : res)
+    {
+        col.resize(n);
+    }
+    parallel_for(
+        n,
+        [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                const auto [l1, l2, l3] =
+                    tri_dual(batch.template get<P>(t));
+                const auto tl1 = ck_term<Plane, L>(pl, l1);
+                const auto tl2 = ck_term<Plane, L>(pl, l2);
+                const auto tl3 = ck_term<Plane, L>(pl, l3);
+                res[0][t] = ck_measure(pl, l2, tl2, l3, tl3,
+                    detail::meet_if_needed<Plane>(l2, l3));
+                res[1][t] = ck_measure(pl, l1, tl1, l3, tl3,
+                    detail::meet_if_needed<Plane>(l1, l3));
+                res[2][t] = ck_measure(pl, l1, tl1, l2, tl2,
+                    detail::meet_if_needed<Plane>(l1, l2));
+            }
+        },
+        64);
+    return res;
+}
+
+/*!
+ * @brief Orthocenters of a batch of triangles in a ck plane
+ *
+ * @param[in] pl
+ * @param[in] batch
+ * @return point_batch<K>
+ */
+template <typename Plane, typename K>
+auto orthocenter(const Plane& pl, const triangle_batch<K>& batch)
+    -> point_batch<K>
+{
+    using P = typename Plane::point_t;
+    const auto n = batch.size();
+    auto res = point_batch<K> {};
+    res.resize(n);
+    parallel_for(
+        n,
+        [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                const auto o = pl.orthocenter(batch.template get<P>(t));
+                res.x[t] = o[0];
+                res.y[t] = o[1];
+                res.z[t] = o[2];
+            }
+        },
+        64);
+    return res;
+}
+
+/*!
+ * @brief Altitudes of a batch of triangles in a ck plane
+ *
+ * Entry i holds the same lines as std::get<i>(pl.tri_altitude(tri)).
+ *
+ * @param[in] pl
+ * @param[in] batch
+ * @return std::array<point_batch<K>, 3>
+ */
+template <typename Plane, typename K>
+auto tri_altitude(const Plane& pl, const triangle_batch<K>& batch)
+    -> std::array<point_batch<K>, 3>
+{
+    using P = typename Plane::point_t;
+    const auto n = batch.size();
+    auto res = std::array<point_batch<K>, 3> {};
+    for (auto& col : res)
+    {
+        col.resize(n);
+    }
+    parallel_for(
+        n,
+        [&](std::size_t first, std::size_t last) {
+            for (auto t = first; t != last; ++t)
+            {
+                const auto [t1, t2, t3] =
+                    pl.tri_altitude(batch.template get<P>(t));
+                const auto put = [t](point_batch<K>& col, const auto& l) {
+                    col.x[t] = l[0];
+                    col.y[t] = l[1];
+                    col.z[t] = l[2];
+                };
+                put(res[0], t1);
+                put(res[1], t2);
+                put(res[2], t3);
+            }
+        },
+        64);
+    return res;
+}
+
+} // namespace fun
@@ -0,0 +1,318 @@
+#pragma once
+
+#include "ck_plane.hpp"
+#include "euclid_plane_measure.hpp"
+#include "fractions.hpp"
+#include "proj_plane.hpp"
+#include "proj_plane_measure.hpp" // import ratio_ratio
+#include <tuple>
+
+/*! @file include/tri_eval.hpp
+ *  This is a C++ Library header.
+ *
+ *  Triangle-level evaluation: every join, perp and omega of a triangle is
+ *  computed once and shared by the derived quantities.
+ */
+
+namespace fun
+{
+
+/*!
+ * @brief Whether the plane measures objects of type X through omega()
+ *        (e.g. persp_euclid_plane) instead of through the perp-based
+ *        cross ratio (e.g. ellck, hyck)
+ */
+template <typename Plane, typename X>
+concept omega_plane = requires(const Plane& pl, const X& x)
+{
+    pl.omega(x);
+};
+
+/*!
+ * @brief Whether the plane provides midpoints
+ */
+template <typename Plane, typename P>
+concept midpoint_plane = requires(const Plane& pl, const P& a, const P& b)
+{
+    { pl.midpoint(a, b) } -> std::convertible_to<P>;
+};
+
+/*!
+ * @brief Terms of one object shared by every measure involving it
+ *
+ * For perp-based planes these are perp(x) and x.perp(x).
+ *
+ * @tparam Plane
+ * @tparam X point or line
+ */
+template <typename Plane, typename X, bool = omega_plane<Plane, X>>
+struct ck_term
+{
+    using K = Value_type<X>;
+    using Y = decltype(std::declval<const Plane&>().perp(std::declval<X>()));
+
+    Y perp;
+    K self;
+
+    /*!
+     * @brief Construct a new ck term object
+     *
+     * @param[in] pl
+     * @param[in] x
+     */
+    constexpr ck_term(const Plane& pl, const X& x)
+        : perp {pl.perp(x)}
+        , self {x.dot(perp)}
+    {
+    }
+};
+
+/*!
+ * @brief Terms of one object shared by every measure involving it
+ *
+ * For omega-based planes this is omega(x).
+ *
+ * @tparam Plane
+ * @tparam X point or line
+ */
+template <typename Plane, typename X>
+struct ck_term<Plane, X, true>
+{
+    using K = Value_type<X>;
+
+    K self;
+
+    /*!
+     * @brief Construct a new ck term object
+     *
+     * @param[in] pl
+     * @param[in] x
+     */
+    constexpr ck_term(const Plane& pl, const X& x)
+        : self {pl.omega(x)}
+    {
+    }
+};
+
+/*!
+ * @brief measure between x1 and x2 from their shared terms
+ *
+ * Gives the same value as pl.measure(x1, x2).
+ *
+ * @param[in] pl
+ * @param[in] x1
+ * @param[in] t1 terms of x1
+ * @param[in] x2
+ * @param[in] t2 terms of x2
+ * @param[in] x12 x1 * x2 (only used by omega-based planes)
+ * @return auto
+ */
+template <typename Plane, typename X, typename Y>
+constexpr auto ck_measure(const Plane& pl, const X& x1,
+    const ck_term<Plane, X>& t1, const X& x2, const ck_term<Plane, X>& t2,
+    [[maybe_unused]] const Y& x12)
+{
+    using K = Value_type<X>;
+    if constexpr (omega_plane<Plane, X>)
+    {
+        const auto omg = K(pl.omega(x12));
+        const auto den = K(t1.self * t2.self);
+        if constexpr (Integral<K>)
+        {
+            return Fraction<K>(omg, den);
+        }
+        else
+        {
+            return omg / den;
+        }
+    }
+    else
+    {
+        return 1 -
+            ratio_ratio(
+                K(x1.dot(t2.perp)), t1.self, t2.self, K(x2.dot(t1.perp)));
+    }
+}
+
+namespace detail
+{
+    // the x12 argument of ck_measure: x1 * x2 for omega-based planes, and
+    // a dummy for perp-based planes, which do not use it
+    template <typename Plane, typename X>
+    constexpr auto meet_if_needed(const X& x1, const X& x2)
+    {
+        if constexpr (omega_plane<Plane, X>)
+        {
+            return x1 * x2;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+} // namespace detail
+
+/*!
+ * @brief Derived quantities of a triangle
+ *
+ * @tparam P
+ * @tparam L
+ * @tparam Q_t quadrance type
+ * @tparam S_t spread type
+ */
+template <typename P, typename L, typename Q_t, typename S_t>
+struct tri_props
+{
+    Triple<L> sides; //!< same as tri_dual(tri)
+    Triple<L> altitudes; //!< same as tri_altitude(tri)
+    P orthocenter;
+    Triple<Q_t> quadrances; //!< same as tri_quadrance(tri)
+    Triple<S_t> spreads; //!< same as tri_spread(tri_dual(tri))
+};
+
+/*!
+ * @brief Derived quantities of a triangle, including the midpoints
+ *
+ * @tparam P
+ * @tparam L
+ * @tparam Q_t quadrance type
+ * @tparam S_t spread type
+ */
+template <typename P, typename L, typename Q_t, typename S_t>
+struct tri_props_mid : tri_props<P, L, Q_t, S_t>
+{
+    Triple<P> midpoints; //!< same as tri_midpoint(tri)
+};
+
+/*!
+ * @brief Evaluate sides, altitudes, orthocenter, quadrances and spreads
+ *        (and midpoints if the plane has them) of a triangle in a ck plane
+ *
+ * Each join, perp and omega is computed once: 6 joins for the sides and
+ * altitudes, one meet for the orthocenter, 3 meets of sides for the
+ * omega-based spreads, and one perp/omega per vertex and per side.
+ *
+ * @param[in] pl
+ * @param[in] tri
+ * @return tri_props or tri_props_mid
+ */
+template <typename Plane, Projective_plane_prim2 P>
+constexpr auto tri_eval(const Plane& pl, const Triple<P>& tri)
+{
+    using L = typename P::dual;
+    const auto& [a1, a2, a3] = tri;
+
+    auto l1 = a2 * a3;
+    auto l2 = a1 * a3;
+    auto l3 = a1 * a2;
+
+    const auto ta1 = ck_term<Plane, P>(pl, a1);
+    const auto ta2 = ck_term<Plane, P>(pl, a2);
+    const auto ta3 = ck_term<Plane, P>(pl, a3);
+    const auto tl1 = ck_term<Plane, L>(pl, l1);
+    const auto tl2 = ck_term<Plane, L>(pl, l2);
+    const auto tl3 = ck_term<Plane, L>(pl, l3);
+
+    const auto perp_of = [&pl](const L& l, const ck_term<Plane, L>& t)
+        -> decltype(auto) {
+        if constexpr (omega_plane<Plane, L>)
+        {
+            return pl.perp(l);
+        }
+        else
+        {
+            return (t.perp);
+        }
+    };
+    auto t1 = a1 * perp_of(l1, tl1);
+    auto t2 = a2 * perp_of(l2, tl2);
+    auto t3 = a3 * perp_of(l3, tl3);
+    auto o = t1 * t2;
+
+    auto quadrances = std::tuple {ck_measure(pl, a2, ta2, a3, ta3, l1),
+        ck_measure(pl, a1, ta1, a3, ta3, l2),
+        ck_measure(pl, a1, ta1, a2, ta2, l3)};
+
+    using detail::meet_if_needed;
+    auto spreads = std::tuple {
+        ck_measure(pl, l2, tl2, l3, tl3, meet_if_needed<Plane>(l2, l3)),
+        ck_measure(pl, l1, tl1, l3, tl3, meet_if_needed<Plane>(l1, l3)),
+        ck_measure(pl, l1, tl1, l2, tl2, meet_if_needed<Plane>(l1, l2))};
+
+    using Q_t = std::tuple_element_t<0, decltype(quadrances)>;
+    using S_t = std::tuple_element_t<0, decltype(spreads)>;
+    auto props = tri_props<P, L, Q_t, S_t> {
+        Triple<L> {std::move(l1), std::move(l2), std::move(l3)},
+        Triple<L> {std::move(t1), std::move(t2), std::move(t3)}, std::move(o),
+        std::move(quadrances), std::move(spreads)};
+
+    if constexpr (midpoint_plane<Plane, P>)
+    {
+        return tri_props_mid<P, L, Q_t, S_t> {std::move(props),
+            Triple<P> {pl.midpoint(a1, a2), pl.midpoint(a2, a3),
+                pl.midpoint(a1, a3)}};
+    }
+    else
+    {
+        return props;
+    }
+}
+
+/*!
+ * @brief Evaluate the Euclidean triangle quantities of euclid_plane.hpp and
+ *        euclid_plane_measure.hpp in one pass
+ *
+ * The side l_i = a_j * a_k gives both the numerator dot1(l_i, l_i) of the
+ * quadrance q_i = dot1(l_i, l_i) / (z_j z_k)^2 and the denominators of the
+ * spreads, so each is computed once per side and each z^2 once per vertex.
+ *
+ * @param[in] tri
+ * @return tri_props_mid
+ */
+template <Projective_plane_coord2 P>
+constexpr auto tri_eval(const Triple<P>& tri)
+{
+    using L = typename P::dual;
+    using K = Value_type<P>;
+    const auto& [a1, a2, a3] = tri;
+
+    auto l1 = a2 * a3;
+    auto l2 = a1 * a3;
+    auto l3 = a1 * a2;
+    const auto d1 = K(dot1(l1, l1));
+    const auto d2 = K(dot1(l2, l2));
+    const auto d3 = K(dot1(l3, l3));
+    const auto zz1 = K(sq(a1[2]));
+    const auto zz2 = K(sq(a2[2]));
+    const auto zz3 = K(sq(a3[2]));
+
+    const auto ratio = [](const K& num, const K& den) {
+        if constexpr (Integral<K>)
+        {
+            return Fraction<K>(num, den);
+        }
+        else
+        {
+            return num / den;
+        }
+    };
+    auto quadrances = std::tuple {ratio(d1, K(zz2 * zz3)),
+        ratio(d2, K(zz1 * zz3)), ratio(d3, K(zz1 * zz2))};
+    auto spreads = std::tuple {ratio(K(sq(cross2(l2, l3))), K(d2 * d3)),
+        ratio(K(sq(cross2(l1, l3))), K(d1 * d3)),
+        ratio(K(sq(cross2(l1, l2))), K(d1 * d2))};
+
+    auto t1 = altitude(a1, l1);
+    auto t2 = altitude(a2, l2);
+    auto t3 = altitude(a3, l3);
+    auto o = t1 * t2;
+
+    using Q_t = std::tuple_element_t<0, decltype(quadrances)>;
+    return tri_props_mid<P, L, Q_t, Q_t> {
+        {Triple<L> {std::move(l1), std::move(l2), std::move(l3)},
+            Triple<L> {std::move(t1), std::move(t2), std::move(t3)},
+            std::move(o), std::move(quadrances), std::move(spreads)},
+        tri_midpoint(tri)};
+}
+
+} // namespace fun
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "ck_plane.hpp"
+#include "proj_plane.hpp"
+#include "tri_eval.hpp" // import ck_term, ck_measure
+#include <array>
+#include <cassert>
+#include <optional>
+#include <utility>
+
+/*! @file include/triangle.hpp
+ *  This is a C++ Library header.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief Triangle in a ck plane with lazily computed, memoized quantities
+ *
+ * Sides, altitudes, orthocenter, quadrances, spreads, midpoints (if the
+ * plane has them) and the sine law are computed on first request and
+ * cached. Moving one vertex with set_vertex() drops only the cached values
+ * that depend on it; e.g. the opposite side and quadrance are kept.
+ *
+ * The plane is held by reference and must outlive the triangle. The caches
+ * are not synchronized, so a triangle must not be queried from several
+ * threads at once.
+ *
+ * Index i refers to the vertex a_i, to the opposite side
+ * l_i = a_j * a_k, and to the quadrance q_i and spread s_i opposite a_i,
+ * as in tri_dual, tri_quadrance and tri_spread. Midpoint indices follow
+ * tri_midpoint: (a1 a2), (a2 a3), (a1 a3).
+ *
+ * @tparam Plane ck plane
+ */
+template <typename Plane>
+class triangle
+{
+    using P = typename Plane::point_t;
+    using L = typename Plane::line_t;
+    using Q_t = decltype(std::declval<const Plane&>().measure(
+        std::declval<const P&>(), std::declval<const P&>()));
+    using S_t = decltype(std::declval<const Plane&>().measure(
+        std::declval<const L&>(), std::declval<const L&>()));
+
+    const Plane& _plane;
+    std::array<P, 3> _pts;
+
+    mutable std::array<std::optional<L>, 3> _sides;
+    mutable std::array<std::optional<ck_term<Plane, P>>, 3> _vertex_terms;
+    mutable std::array<std::optional<ck_term<Plane, L>>, 3> _side_terms;
+    mutable std::array<std::optional<L>, 3> _altitudes;
+    mutable std::optional<P> _orthocenter;
+    mutable std::array<std::optional<Q_t>, 3> _quadrances;
+    mutable std::array<std::optional<S_t>, 3> _spreads;
+    mutable std::array<std::optional<P>, 3> _midpoints;
+    mutable std::optional<bool> _sine_law;
+
+    // the two indices other than i, in increasing order
+    static constexpr auto others(std::size_t i)
+        -> std::pair<std::size_t, std::size_t>
+    {
+        return {i == 0 ? 1U : 0U, i == 2 ? 1U : 2U};
+    }
+
+    // midpoint index -> vertex indices, see tri_midpoint
+    static constexpr auto mid_ends(std::size_t i)
+        -> std::pair<std::size_t, std::size_t>
+    {
+        if (i == 0)
+        {
+            return {0, 1};
+        }
+        return i == 1 ? std::pair<std::size_t, std::size_t> {1, 2}
+                      : std::pair<std::size_t, std::size_t> {0, 2};
+    }
+
+  public:
+    /*!
+     * @brief Construct a new triangle object
+     *
+     * @param[in] plane
+     * @param[in] a1
+     * @param[in] a2
+     * @param[in] a3
+     */
+    triangle(const Plane& plane, P a1, P a2, P a3)
+        : _plane {plane}
+        , _pts {std::move(a1), std::move(a2), std::move(a3)}
+    {
+    }
+
+    /*!
+     * @brief Construct a new triangle object
+     *
+     * @param[in] plane
+     * @param[in] tri
+     */
+    triangle(const Plane& plane, const Triple<P>& tri)
+        : triangle {plane, P {std::get<0>(tri)}, P {std::get<1>(tri)},
+              P {std::get<2>(tri)}}
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] i
+     * @return const P&
+     */
+    [[nodiscard]] auto vertex(std::size_t i) const -> const P&
+    {
+        return this->_pts[i];
+    }
+
+    /*!
+     * @brief Move vertex i, invalidating only the values depending on it
+     *
+     * @param[in] i
+     * @param[in] p
+     */
+    void set_vertex(std::size_t i, P p)
+    {
+        assert(i < 3);
+        this->_pts[i] = std::move(p);
+        const auto [j, k] = others(i);
+        this->_vertex_terms[i].reset();
+        for (auto m : {j, k})
+        {
+            this->_sides[m].reset();
+            this->_side_terms[m].reset();
+            this->_quadrances[m].reset();
+        }
+        for (auto m = 0U; m != 3; ++m)
+        {
+            this->_altitudes[m].reset();
+            this->_spreads[m].reset();
+            const auto [u, v] = mid_ends(m);
+            if (u == i || v == i)
+            {
+                this->_midpoints[m].reset();
+            }
+        }
+        this->_orthocenter.reset();
+        this->_sine_law.reset();
+    }
+
+    /*!
+     * @brief side opposite vertex i
+     *
+     * @param[in] i
+     * @return const L&
+     */
+    [[nodiscard]] auto side(std::size_t i) const -> const L&
+    {
+        if (!this->_sides[i])
+        {
+            const auto [j, k] = others(i);
+            this->_sides[i].emplace(this->_pts[j] * this->_pts[k]);
+        }
+        return *this->_sides[i];
+    }
+
+    /*!
+     * @brief altitude through vertex i
+     *
+     * @param[in] i
+     * @return const L&
+     */
+    [[nodiscard]] auto altitude(std::size_t i) const -> const L&
+    {
+        if (!this->_altitudes[i])
+        {
+            if constexpr (omega_plane<Plane, L>)
+            {
+                this->_altitudes[i].emplace(
+                    this->_pts[i] * this->_plane.perp(this->side(i)));
+            }
+            else
+            {
+                this->_altitudes[i].emplace(
+                    this->_pts[i] * this->side_term(i).perp);
+            }
+        }
+        return *this->_altitudes[i];
+    }
+
+    /*!
+     * @brief
+     *
+     * @return const P&
+     */
+    [[nodiscard]] auto orthocenter() const -> const P&
+    {
+        if (!this->_orthocenter)
+        {
+            this->_orthocenter.emplace(this->altitude(0) * this->altitude(1));
+        }
+        return *this->_orthocenter;
+    }
+
+    /*!
+     * @brief quadrance opposite vertex i
+     *
+     * @param[in] i
+     * @return const Q_t&
+     */
+    [[nodiscard]] auto quadrance(std::size_t i) const -> const Q_t&
+    {
+        if (!this->_quadrances[i])
+        {
+            const auto [j, k] = others(i);
+            this->_quadrances[i].emplace(ck_measure(this->_plane,
+                this->_pts[j], this->vertex_term(j), this->_pts[k],
+                this->vertex_term(k), this->side(i)));
+        }
+        return *this->_quadrances[i];
+    }
+
+    /*!
+     * @brief spread at vertex i (between the sides j and k)
+     *
+     * @param[in] i
+     * @return const S_t&
+     */
+    [[nodiscard]] auto spread(std::size_t i) const -> const S_t&
+    {
+        if (!this->_spreads[i])
+        {
+            const auto [j, k] = others(i);
+            const auto& lj = this->side(j);
+            const auto& lk = this->side(k);
+            this->_spreads[i].emplace(ck_measure(this->_plane, lj,
+                this->side_term(j), lk, this->side_term(k),
+                detail::meet_if_needed<Plane>(lj, lk)));
+        }
+        return *this->_spreads[i];
+    }
+
+    /*!
+     * @brief midpoint i, in the order of tri_midpoint
+     *
+     * @param[in] i
+     * @return const P&
+     */
+    [[nodiscard]] auto midpoint(std::size_t i) const -> const P&
+    requires midpoint_plane<Plane, P>
+    {
+        if (!this->_midpoints[i])
+        {
+            const auto [u, v] = mid_ends(i);
+            this->_midpoints[i].emplace(
+                this->_plane.midpoint(this->_pts[u], this->_pts[v]));
+        }
+        return *this->_midpoints[i];
+    }
+
+    /*!
+     * @brief whether the sine law holds, see check_sine_law
+     *
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] auto sine_law() const -> bool
+    {
+        if (!this->_sine_law)
+        {
+            const auto& q1 = this->quadrance(0);
+            const auto& q2 = this->quadrance(1);
+            const auto& q3 = this->quadrance(2);
+            const auto& s1 = this->spread(0);
+            const auto& s2 = this->spread(1);
+            const auto& s3 = this->spread(2);
+            this->_sine_law = (s1 * q2 == s2 * q1) && (s2 * q3 == s3 * q2);
+        }
+        return *this->_sine_law;
+    }
+
+  private:
+    auto vertex_term(std::size_t i) const -> const ck_term<Plane, P>&
+    {
+        if (!this->_vertex_terms[i])
+        {
+            this->_vertex_terms[i].emplace(this->_plane, this->_pts[i]);
+        }
+        return *this->_vertex_terms[i];
+    }
+
+    auto side_term(std::size_t i) const -> const ck_term<Plane, L>&
+    {
+        if (!this->_side_terms[i])
+        {
+            this->_side_terms[i].emplace(this->_plane, this->side(i));
+        }
+        return *this->_side_terms[i];
+    }
+};
+
+} // namespace fun
@@ -0,0 +1,633 @@
+#pragma once
+
+#include "checked_int.hpp"
+#include "ck_plane.hpp"
+#include "fractions.hpp"
+#include "parallel.hpp"
+#include "pg_line.hpp"
+#include "pg_point.hpp"
+#include "proj_plane.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+/*! @file include/verify.hpp
+ *  This is a C++ Library header.
+ *
+ *  Randomized verification of the incidence and ck-plane theorems.
+ *  Configuration i of a campaign is generated from its own generator
+ *  seeded by (seed, i), so results do not depend on the thread schedule
+ *  and a counterexample can be regenerated from its index alone.
+ */
+
+namespace fun
+{
+
+/**
+ * @brief splitmix64 generator
+ *
+ */
+struct verify_rng
+{
+    std::uint64_t state;
+
+    /*!
+     * @brief generator of configuration index of a campaign
+     *
+     * @param[in] seed
+     * @param[in] index
+     */
+    constexpr verify_rng(std::uint64_t seed, std::uint64_t index)
+        : state {seed * 0x9E3779B97F4A7C15ULL + index}
+    {
+        this->next(); // decorrelate neighbouring indices
+    }
+
+    /*!
+     * @brief
+     *
+     * @return std::uint64_t
+     */
+    constexpr auto next() -> std::uint64_t
+    {
+        auto z = (this->state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31U);
+    }
+
+    /*!
+     * @brief uniform integer in [-bound, bound]
+     *
+     * @param[in] bound
+     * @return std::int64_t
+     */
+    constexpr auto uniform(std::int64_t bound) -> std::int64_t
+    {
+        const auto width = std::uint64_t(2 * bound + 1);
+        return std::int64_t(this->next() % width) - bound;
+    }
+
+    /*!
+     * @brief uniform real in [-1, 1)
+     *
+     * @return double
+     */
+    constexpr auto real() -> double
+    {
+        return double(this->next() >> 11U) * 0x1p-52 - 1.0;
+    }
+};
+
+namespace detail
+{
+    template <typename K>
+    struct is_fraction : std::false_type
+    {
+    };
+
+    template <typename Z>
+    struct is_fraction<Fraction<Z>> : std::true_type
+    {
+        using int_type = Z;
+    };
+
+    template <typename K>
+    auto random_coord(verify_rng& rng, std::int64_t bound) -> K
+    {
+        if constexpr (std::floating_point<K>)
+        {
+            return K(rng.real() * double(bound));
+        }
+        else if constexpr (is_fraction<K>::value)
+        {
+            using Z = typename is_fraction<K>::int_type;
+            const auto den = rng.uniform(bound);
+            return K(Z(rng.uniform(bound)), Z(den == 0 ? 1 : den));
+        }
+        else
+        {
+            return K(rng.uniform(bound));
+        }
+    }
+
+    template <typename P>
+    auto random_point(verify_rng& rng, std::int64_t bound) -> P
+    {
+        using K = Value_type<P>;
+        return P {random_coord<K>(rng, bound), random_coord<K>(rng, bound),
+            random_coord<K>(rng, bound)};
+    }
+
+    template <typename P>
+    auto is_null(const P& p) -> bool
+    {
+        using K = Value_type<P>;
+        return p[0] == K(0) && p[1] == K(0) && p[2] == K(0);
+    }
+
+    // p scaled to max-norm 1, so that floating point residuals are relative
+    template <typename P>
+    auto unit(const P& p) -> P
+    {
+        using K = Value_type<P>;
+        const auto m =
+            std::max({std::abs(p[0]), std::abs(p[1]), std::abs(p[2])});
+        return P {K(p[0] / m), K(p[1] / m), K(p[2] / m)};
+    }
+
+    // a == b, up to a relative tolerance for floating point values
+    template <typename K>
+    auto approx_equal(const K& a, const K& b, double tol) -> bool
+    {
+        if constexpr (std::floating_point<K>)
+        {
+            const auto scale = std::max({K(1), std::abs(a), std::abs(b)});
+            return std::abs(a - b) <= K(tol) * scale;
+        }
+        else
+        {
+            return a == b;
+        }
+    }
+
+    // points G, H, I collinear, up to tol for floating point coordinates
+    template <typename P>
+    auto collinear(const P& G, const P& H, const P& I, double tol) -> bool
+    {
+        using K = Value_type<P>;
+        if constexpr (std::floating_point<K>)
+        {
+            return std::abs(unit(G).dot(unit(H) * unit(I))) <= K(tol);
+        }
+        else
+        {
+            return incident(I, G * H);
+        }
+    }
+
+    // three distinct collinear points
+    template <typename P>
+    auto random_collinear(verify_rng& rng, std::int64_t bound) -> Triple<P>
+    {
+        using K = Value_type<P>;
+        for (;;)
+        {
+            auto A = random_point<P>(rng, bound);
+            auto B = random_point<P>(rng, bound);
+            if (is_null(A * B))
+            {
+                continue;
+            }
+            auto C = plucker(random_coord<K>(rng, bound), A,
+                random_coord<K>(rng, bound), B);
+            if (is_null(A * C) || is_null(B * C))
+            {
+                continue;
+            }
+            return {std::move(A), std::move(B), std::move(C)};
+        }
+    }
+
+    // three non-collinear points
+    template <typename P>
+    auto random_triangle(verify_rng& rng, std::int64_t bound) -> Triple<P>
+    {
+        using K = Value_type<P>;
+        for (;;)
+        {
+            auto A = random_point<P>(rng, bound);
+            auto B = random_point<P>(rng, bound);
+            auto C = random_point<P>(rng, bound);
+            if (C.dot(A * B) != K(0))
+            {
+                return {std::move(A), std::move(B), std::move(C)};
+            }
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief Pappus Theorem on two random collinear triples
+ *
+ * @tparam K coordinate type
+ */
+template <typename K>
+struct pappus_theorem
+{
+    using P = pg_point<K>;
+    using value_type = K;
+
+    /*!
+     * @brief
+     *
+     * @param[in] rng
+     * @param[in] bound coordinates are drawn from [-bound, bound]
+     * @param[in] tol tolerance for floating point K
+     * @return whether the theorem holds for the configuration
+     */
+    auto operator()(verify_rng& rng, std::int64_t bound, double tol) const
+        -> bool
+    {
+        for (;;)
+        {
+            const auto co1 = detail::random_collinear<P>(rng, bound);
+            const auto co2 = detail::random_collinear<P>(rng, bound);
+            const auto& [A, B, C] = co1;
+            const auto& [D, E, F] = co2;
+            const auto G = (A * E) * (B * D);
+            const auto H = (A * F) * (C * D);
+            const auto I = (B * F) * (C * E);
+            if (detail::is_null(G) || detail::is_null(H) ||
+                detail::is_null(I))
+            {
+                continue; // some cross join degenerates
+            }
+            if constexpr (std::floating_point<K>)
+            {
+                return detail::collinear(G, H, I, tol);
+            }
+            else
+            {
+                return pappus_holds(co1, co2);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Desargues Theorem on two random triangles perspective from a
+ *        point
+ *
+ * @tparam K coordinate type
+ */
+template <typename K>
+struct desargue_theorem
+{
+    using P = pg_point<K>;
+    using value_type = K;
+
+    /*!
+     * @brief
+     *
+     * @param[in] rng
+     * @param[in] bound coordinates are drawn from [-bound, bound]
+     * @param[in] tol tolerance for floating point K
+     * @return whether the theorem holds for the configuration
+     */
+    auto operator()(verify_rng& rng, std::int64_t bound, double tol) const
+        -> bool
+    {
+        const auto coord = [&] { return detail::random_coord<K>(rng, bound); };
+        for (;;)
+        {
+            const auto O = detail::random_point<P>(rng, bound);
+            auto tri1 = detail::random_triangle<P>(rng, bound);
+            const auto& [A, B, C] = tri1;
+            auto tri2 = Triple<P> {plucker(coord(), O, coord(), A),
+                plucker(coord(), O, coord(), B),
+                plucker(coord(), O, coord(), C)};
+            const auto& [D, E, F] = tri2;
+            if (F.dot(D * E) == K(0))
+            {
+                continue;
+            }
+            const auto X = (A * B) * (D * E);
+            const auto Y = (A * C) * (D * F);
+            const auto Z = (B * C) * (E * F);
+            if (detail::is_null(X) || detail::is_null(Y) ||
+                detail::is_null(Z))
+            {
+                continue; // a pair of corresponding sides coincides
+            }
+            if constexpr (std::floating_point<K>)
+            {
+                return detail::collinear(X, Y, Z, tol);
+            }
+            else
+            {
+                return desargue_holds(tri1, tri2);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Sine law on a random triangle of the elliptic plane
+ *
+ * @tparam K coordinate type
+ */
+template <typename K>
+struct sine_law_theorem
+{
+    using P = pg_point<K>;
+    using value_type = K;
+
+    /*!
+     * @brief
+     *
+     * @param[in] rng
+     * @param[in] bound coordinates are drawn from [-bound, bound]
+     * @param[in] tol tolerance for floating point K
+     * @return whether the theorem holds for the configuration
+     */
+    auto operator()(verify_rng& rng, std::int64_t bound, double tol) const
+        -> bool
+    {
+        const auto myck = ellck<P>();
+        const auto tri = detail::random_triangle<P>(rng, bound);
+        const auto [q1, q2, q3] = myck.tri_quadrance(tri);
+        const auto [s1, s2, s3] = myck.tri_spread(tri_dual(tri));
+        return detail::approx_equal(s1 * q2, s2 * q1, tol) &&
+            detail::approx_equal(s2 * q3, s3 * q2, tol);
+    }
+};
+
+/**
+ * @brief Cross law on a random triangle of the elliptic plane
+ *
+ * @tparam K coordinate type
+ */
+template <typename K>
+struct cross_law_theorem
+{
+    using P = pg_point<K>;
+    using value_type = K;
+
+    /*!
+     * @brief
+     *
+     * @param[in] rng
+     * @param[in] bound coordinates are drawn from [-bound, bound]
+     * @param[in] tol tolerance for floating point K
+     * @return whether the theorem holds for the configuration
+     */
+    auto operator()(verify_rng& rng, std::int64_t bound, double tol) const
+        -> bool
+    {
+        const auto myck = ellck<P>();
+        const auto tri = detail::random_triangle<P>(rng, bound);
+        const auto Q = myck.tri_quadrance(tri);
+        const auto S = myck.tri_spread(tri_dual(tri));
+        const auto res = check_cross_law(S, std::get<2>(Q));
+        return detail::approx_equal(res, decltype(res)(0), tol);
+    }
+};
+
+/**
+ * @brief Triple quad formula on three random collinear points of the
+ *        elliptic plane
+ *
+ * @tparam K coordinate type
+ */
+template <typename K>
+struct cross_TQF_theorem
+{
+    using P = pg_point<K>;
+    using value_type = K;
+
+    /*!
+     * @brief
+     *
+     * @param[in] rng
+     * @param[in] bound coordinates are drawn from [-bound, bound]
+     * @param[in] tol tolerance for floating point K
+     * @return whether the theorem holds for the configuration
+     */
+    auto operator()(verify_rng& rng, std::int64_t bound, double tol) const
+        -> bool
+    {
+        const auto myck = ellck<P>();
+        const auto collin = detail::random_collinear<P>(rng, bound);
+        const auto res = check_cross_TQF(myck.tri_quadrance(collin));
+        return detail::approx_equal(res, decltype(res)(0), tol);
+    }
+};
+
+namespace detail
+{
+    // the coordinate type whose overflows throw
+    template <typename K>
+    struct checked_coord
+    {
+        using type = K;
+    };
+
+    template <std::signed_integral Z>
+    struct checked_coord<Z>
+    {
+        using type = checked_int<Z>;
+    };
+
+    template <std::signed_integral Z>
+    struct checked_coord<Fraction<Z>>
+    {
+        using type = Fraction<checked_int<Z>>;
+    };
+
+    // Thm<K> run over checked_coord<K> instead, for the theorems above;
+    // any other callable is run as it is
+    template <typename Theorem>
+    struct checked_theorem
+    {
+        static auto get(const Theorem& thm) -> const Theorem&
+        {
+            return thm;
+        }
+    };
+
+    template <template <typename> class Thm, typename K>
+    requires std::same_as<typename Thm<K>::value_type, K>
+    struct checked_theorem<Thm<K>>
+    {
+        static auto get(const Thm<K>& /* thm */)
+        {
+            return Thm<typename checked_coord<K>::type> {};
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Options of a verification campaign
+ *
+ */
+struct verify_options
+{
+    std::uint64_t seed = 1;
+    std::uint64_t count = 1U << 16U; //!< total number of configurations
+    std::uint64_t block = 1U << 12U; //!< configurations per checkpoint
+    std::int64_t bound = 100; //!< coordinates are drawn from [-bound, bound]
+    double tolerance = 1e-9; //!< relative tolerance for floating point K
+    std::string checkpoint; //!< checkpoint file, none if empty
+    std::size_t max_counterexamples = 16;
+};
+
+/**
+ * @brief Outcome of a verification campaign
+ *
+ */
+struct verify_report
+{
+    std::uint64_t checked = 0; //!< including those of resumed runs
+    std::uint64_t failed = 0;
+    /// configurations whose intermediate values overflowed, counted
+    /// neither as holding nor as failing
+    std::uint64_t overflowed = 0;
+    std::vector<std::uint64_t> counterexamples; //!< configuration indices
+    std::uint64_t checked_now = 0; //!< checked by this run
+    double seconds = 0.; //!< time taken by this run
+
+    /*!
+     * @brief configurations per second of this run
+     *
+     * @return double
+     */
+    [[nodiscard]] auto rate() const -> double
+    {
+        return this->seconds > 0. ? double(this->checked_now) / this->seconds
+                                  : 0.;
+    }
+};
+
+namespace detail
+{
+    // pgcpp-verify "theorem" seed bound next failed overflowed n c1 .. cn
+    template <typename Theorem>
+    auto load_checkpoint(const verify_options& opt, verify_report& rep)
+        -> bool
+    {
+        auto ifs = std::ifstream {opt.checkpoint};
+        auto tag = std::string {};
+        auto name = std::string {};
+        auto seed = std::uint64_t {};
+        auto bound = std::int64_t {};
+        auto n = std::size_t {};
+        if (ifs >> tag >> std::quoted(name) >> seed >> bound >>
+                rep.checked >> rep.failed >> rep.overflowed >> n &&
+            tag == "pgcpp-verify" && name == typeid(Theorem).name() &&
+            seed == opt.seed && bound == opt.bound &&
+            n <= opt.max_counterexamples)
+        {
+            rep.counterexamples.resize(n);
+            for (auto& c : rep.counterexamples)
+            {
+                ifs >> c;
+            }
+            if (ifs)
+            {
+                return true;
+            }
+        }
+        rep = verify_report {};
+        return false;
+    }
+
+    template <typename Theorem>
+    inline void save_checkpoint(
+        const verify_options& opt, const verify_report& rep)
+    {
+        const auto tmp = opt.checkpoint + ".tmp";
+        {
+            auto ofs = std::ofstream {tmp, std::ios::trunc};
+            ofs << "pgcpp-verify " << std::quoted(typeid(Theorem).name())
+                << ' ' << opt.seed << ' ' << opt.bound << ' ' << rep.checked
+                << ' ' << rep.failed << ' ' << rep.overflowed << ' '
+                << rep.counterexamples.size();
+            for (const auto& c : rep.counterexamples)
+            {
+                ofs << ' ' << c;
+            }
+            ofs << '\n';
+        }
+        std::rename(tmp.c_str(), opt.checkpoint.c_str());
+    }
+} // namespace detail
+
+/*!
+ * @brief Check a theorem on opt.count random configurations in parallel
+ *
+ * Configurations are processed in blocks of opt.block. After each block
+ * the progress is written to opt.checkpoint (if given), and a later call
+ * with the same theorem, seed, bound and checkpoint file resumes from
+ * there. Configuration i can be regenerated by calling thm with a
+ * verify_rng {opt.seed, i}. The theorems above over builtin integers (or
+ * fractions of them) are run over checked_int, and a configuration whose
+ * intermediate values overflow, i.e. for which thm throws
+ * std::overflow_error, is counted in overflowed instead of failed.
+ *
+ * @param[in] thm callable (verify_rng&, bound, tolerance) -> bool
+ * @param[in] opt
+ * @return verify_report
+ */
+template <typename Theorem>
+auto verify(const Theorem& thm, const verify_options& opt) -> verify_report
+{
+    auto rep = verify_report {};
+    if (!opt.checkpoint.empty())
+    {
+        detail::load_checkpoint<Theorem>(opt, rep);
+    }
+    const auto& run = detail::checked_theorem<Theorem>::get(thm);
+    const auto start = std::chrono::steady_clock::now();
+    const auto block = std::max<std::uint64_t>(opt.block, 1);
+    auto ok = std::vector<char>(block);
+    while (rep.checked < opt.count)
+    {
+        const auto first = rep.checked;
+        const auto n = std::min(block, opt.count - first);
+        parallel_for(
+            n,
+            [&](std::size_t lo, std::size_t hi) {
+                for (auto i = lo; i != hi; ++i)
+                {
+                    auto rng = verify_rng {opt.seed, first + i};
+                    try
+                    {
+                        ok[i] = char(run(rng, opt.bound, opt.tolerance));
+                    }
+                    catch (const std::overflow_error&)
+                    {
+                        ok[i] = 2;
+                    }
+                }
+            },
+            16);
+        for (auto i = 0U; i != n; ++i)
+        {
+            if (ok[i] == 2)
+            {
+                ++rep.overflowed;
+            }
+            else if (ok[i] == 0)
+            {
+                ++rep.failed;
+                if (rep.counterexamples.size() < opt.max_counterexamples)
+                {
+                    rep.counterexamples.push_back(first + i);
+                }
+            }
+        }
+        rep.checked += n;
+        rep.checked_now += n;
+        if (!opt.checkpoint.empty())
+        {
+            detail::save_checkpoint<Theorem>(opt, rep);
+        }
+    }
+    rep.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start)
+                      .count();
+    return rep;
+}
+
+} // namespace fun
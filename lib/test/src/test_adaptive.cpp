@@ -0,0 +1,89 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/adaptive.hpp"
+#include "pgcpp/euclid_plane.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include "pgcpp/verify.hpp"
+#include <doctest/doctest.h>
+#include <span>
+#include <tuple>
+#include <vector>
+
+using namespace fun;
+
+TEST_CASE("Adaptive incidence and collinearity")
+{
+    using P = pg_point<double>;
+    using L = pg_line<double>;
+    auto rng = verify_rng {3, 0};
+
+    // a line through two points, and points on it up to rounding
+    auto items = std::vector<std::tuple<P, L>> {};
+    auto triples = std::vector<std::tuple<P, P, P>> {};
+    for (auto i = 0; i != 400; ++i)
+    {
+        const auto a = P {rng.real(), rng.real(), 1.};
+        const auto b = P {rng.real(), rng.real(), 1.};
+        const auto t = rng.real();
+        auto c = P {a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1]), 1.};
+        if (i % 4 == 0)
+        {
+            c = P {rng.real(), rng.real(), 1.}; // generic position
+        }
+        triples.emplace_back(P {a}, P {b}, P {c});
+        items.emplace_back(P {c}, a * b);
+    }
+    items.emplace_back(P {1., 2., 1.}, L {1., 1., -3.}); // exactly incident
+    items.emplace_back(P {1e-200, 0., 0.}, L {1e-200, 0., 0.}); // underflow
+
+    auto sign = std::vector<int>(items.size());
+    const auto rep = adaptive_sign(incidence_query {},
+        std::span<const std::tuple<P, L>>(items), std::span<int>(sign));
+    CHECK(rep.count == items.size());
+    CHECK(rep.fallbacks > 0);
+    CHECK(rep.fallbacks < items.size());
+    CHECK(rep.fallback_rate() < 0.8);
+    CHECK(sign[sign.size() - 2] == 0);
+    CHECK(sign.back() == 1);
+
+    // the signs agree with an exact evaluation of all items
+    auto agree = true;
+    for (auto i = 0U; i != items.size(); ++i)
+    {
+        const auto& [p, l] = items[i];
+        const auto v = detail::to_exact(p).dot(detail::to_exact(l));
+        agree = agree && sign[i] == detail::exact_sign(v);
+    }
+    CHECK(agree);
+
+    auto sign3 = std::vector<int>(triples.size());
+    const auto rep3 = adaptive_sign(collinear_query {},
+        std::span<const std::tuple<P, P, P>>(triples), std::span<int>(sign3));
+    CHECK(rep3.fallbacks >= 250); // the near-collinear ones
+    CHECK(rep3.fallbacks < triples.size());
+}
+
+TEST_CASE("Adaptive parallel and perpendicular")
+{
+    using L = pg_line<double>;
+    const auto lines = std::vector<std::tuple<L, L>> {
+        {L {1., 2., 3.}, L {2., 4., 5.}}, // parallel
+        {L {0.1, 0.7, 3.}, L {0.3, 2.1, 5.}}, // parallel up to rounding
+        {L {1., 2., 3.}, L {2., -1., 5.}}, // perpendicular
+        {L {1., 2., 3.}, L {2., 1., 5.}}};
+    auto sign = std::vector<int>(lines.size());
+    const auto span = std::span<const std::tuple<L, L>>(lines);
+    adaptive_sign(parallel_query {}, span, std::span<int>(sign));
+    CHECK(sign[0] == 0);
+    const auto& [l1, m1] = lines[1];
+    CHECK(sign[1] ==
+        detail::exact_sign(
+            cross2(detail::to_exact(l1), detail::to_exact(m1))));
+    CHECK(sign[3] != 0);
+    adaptive_sign(perpendicular_query {}, span, std::span<int>(sign));
+    CHECK(sign[2] == 0);
+    CHECK(sign[3] != 0);
+}
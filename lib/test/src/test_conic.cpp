@@ -0,0 +1,129 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/conic.hpp"
+#include "pgcpp/euclid_plane.hpp" // import uc_point
+#include "pgcpp/gf_p.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace fun;
+
+TEST_CASE("Conic (cpp_int)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+    using L = pg_line<cpp_int>;
+
+    const auto C = conic<P> {uc_point<P>(1, 0), uc_point<P>(3, 4),
+        uc_point<P>(-1, 2), uc_point<P>(0, 1), uc_point<P>(2, 5)};
+    // unit circle x^2 + y^2 - z^2, up to sign
+    const auto& M = C.matrix();
+    CHECK(M[0][0] == -M[2][2]);
+    CHECK(M[0][0] == M[1][1]);
+    CHECK(M[0][1] == 0);
+    CHECK(C.incident(uc_point<P>(7, -3)));
+    CHECK(!C.incident(P {1, 1, 1}));
+
+    const auto p = P {3, 5, 2};
+    CHECK(C.pole(C.polar(p)) == p);
+
+    // the y-axis meets the circle at (0, +-1, 1)
+    const auto pts = C.meet(L {1, 0, 0});
+    REQUIRE(pts.has_value());
+    CHECK(C.incident(pts->first));
+    CHECK(C.incident(pts->second));
+    CHECK(pts->first != pts->second);
+    // the line 2y = z meets it at (+-sqrt(3)/2, 1/2)
+    CHECK(!C.meet(L {0, 2, -1}).has_value());
+
+    // tangents from (5/4, 0): touch points (4/5, +-3/5)
+    const auto tgs = C.tangents(P {5, 0, 4});
+    REQUIRE(tgs.has_value());
+    CHECK(incident(P {4, 3, 5}, tgs->first) ||
+        incident(P {4, 3, 5}, tgs->second));
+    CHECK(incident(P {4, -3, 5}, tgs->first) ||
+        incident(P {4, -3, 5}, tgs->second));
+    const auto t = C.tangents(P {0, 1, 1});
+    REQUIRE(t.has_value());
+    CHECK(t->first == L {0, 1, -1});
+
+    auto src = std::vector<P> {};
+    for (auto i = 0; i != 20; ++i)
+    {
+        src.emplace_back(i, 1 - i, 3);
+    }
+    auto lns = std::vector<L>(src.size(), L {0, 0, 0});
+    auto poles = std::vector<P>(src.size(), P {0, 0, 0});
+    C.polar(std::span<const P> {src}, std::span<L> {lns});
+    C.pole(std::span<const L> {lns}, std::span<P> {poles});
+    CHECK(lns[7] == C.polar(src[7]));
+    CHECK(poles[7] == src[7]);
+}
+
+TEST_CASE("Conic (gf_p)")
+{
+    using K = gf_p<101>;
+    using P = pg_point<K>;
+    using L = pg_line<K>;
+
+    // x^2 + y^2 - z^2 over GF(101)
+    const auto C = conic<P> {Mat3<K> {{{K(1), K(0), K(0)},
+        {K(0), K(1), K(0)}, {K(0), K(0), K(-1)}}}};
+    auto pts = std::vector<P> {};
+    for (auto x = 0; x != 101; ++x)
+    {
+        for (auto y = 0; y != 101; ++y)
+        {
+            pts.emplace_back(K(x), K(y), K(1));
+        }
+        pts.emplace_back(K(x), K(1), K(0));
+    }
+    pts.emplace_back(K(1), K(0), K(0));
+
+    // meet finds the points of the line on the conic exactly when they
+    // are defined over GF(101)
+    auto ok = true;
+    for (auto i = 0; i != 300; ++i)
+    {
+        const auto l = L {K(i % 7 - 3), K(i / 7 - 20), K(i % 11 + 1)};
+        auto n_on = 0;
+        for (const auto& p : pts)
+        {
+            n_on += (incident(l, p) && C.incident(p)) ? 1 : 0;
+        }
+        const auto m = C.meet(l);
+        ok = ok && m.has_value() == (n_on != 0);
+        if (m)
+        {
+            ok = ok && C.incident(m->first) && C.incident(m->second);
+            ok = ok && incident(l, m->first) && incident(l, m->second);
+            ok = ok && (m->first == m->second) == (n_on == 1);
+        }
+    }
+    CHECK(ok);
+
+    // a line lying on the line pair 2xy == 0
+    const auto D = conic<P> {Mat3<K> {{{K(0), K(1), K(0)},
+        {K(1), K(0), K(0)}, {K(0), K(0), K(0)}}}};
+    CHECK(!D.meet(L {K(1), K(0), K(0)}).has_value());
+    CHECK(D.meet(L {K(1), K(1), K(0)}).has_value());
+}
+
+TEST_CASE("Conic (double)")
+{
+    using P = pg_point<double>;
+    using L = pg_line<double>;
+
+    const auto C = conic<P> {Mat3<double> {
+        {{1., 0., 0.}, {0., 1., 0.}, {0., 0., -1.}}}};
+    const auto pts = C.meet(L {0., 2., -1.});
+    REQUIRE(pts.has_value());
+    const auto& [a, b] = *pts;
+    CHECK(dot_c(a, mat3_vec(C.matrix(), a)) == doctest::Approx(0));
+    CHECK(dot_c(b, mat3_vec(C.matrix(), b)) == doctest::Approx(0));
+    CHECK(!C.meet(L {0., 1., -2.}).has_value());
+}
@@ -0,0 +1,118 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/common_concepts.h"
+#include "pgcpp/dual_num.hpp"
+#include "pgcpp/euclid_plane_measure.hpp"
+#include "pgcpp/persp_plane.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include <array>
+#include <doctest/doctest.h>
+
+using namespace fun;
+
+using D = dual_num<double, 4>;
+static_assert(ordered_ring<D>);
+static_assert(!Integral<D>);
+
+/*!
+ * @brief Gradient of f at x by central differences
+ *
+ * @param[in] f
+ * @param[in] x
+ * @return std::array<double, 4>
+ */
+template <typename Fn>
+auto num_grad(const Fn& f, std::array<double, 4> x) -> std::array<double, 4>
+{
+    auto g = std::array<double, 4> {};
+    const auto h = 1e-6;
+    for (auto i = 0U; i != 4; ++i)
+    {
+        auto xp = x;
+        auto xm = x;
+        xp[i] += h;
+        xm[i] -= h;
+        g[i] = (f(xp) - f(xm)) / (2 * h);
+    }
+    return g;
+}
+
+/*!
+ * @brief Check the gradient of measure(a, b), a = (x0, x1, 1) and
+ *        b = (x2, x3, 2), against central differences
+ *
+ * @param[in] measure generic callable (P, P) -> scalar
+ */
+template <typename Fn>
+void chk_gradient(const Fn& measure)
+{
+    const auto x = std::array {0.3, -1.2, 2.5, 0.7};
+    const auto f = [&](const std::array<double, 4>& v) {
+        using P = pg_point<double>;
+        return double(measure(P {v[0], v[1], 1.}, P {v[2], v[3], 2.}));
+    };
+    using P = pg_point<D>;
+    const auto a = P {D::variable(x[0], 0), D::variable(x[1], 1), D(1.)};
+    const auto b = P {D::variable(x[2], 2), D::variable(x[3], 3), D(2.)};
+    const auto m = measure(a, b);
+    CHECK(m.value() == doctest::Approx(f(x)));
+    const auto g = num_grad(f, x);
+    for (auto i = 0U; i != 4; ++i)
+    {
+        CHECK(m.d(i) == doctest::Approx(g[i]).epsilon(1e-5));
+    }
+}
+
+TEST_CASE("Dual number arithmetic")
+{
+    const auto x = D::variable(3., 0);
+    const auto y = D::variable(-2., 1);
+    const auto f = x * x * y - 1 / y + 2 * x;
+    CHECK(f.value() == doctest::Approx(-18 + 0.5 + 6));
+    CHECK(f.d(0) == doctest::Approx(2 * 3 * -2 + 2)); // 2 x y + 2
+    CHECK(f.d(1) == doctest::Approx(9 + 1. / 4)); // x^2 + 1 / y^2
+    CHECK(f.d(2) == 0);
+    CHECK(sqrt(x * x).d(0) == doctest::Approx(1.));
+    CHECK(abs(y).d(1) == -1);
+    CHECK(y < x);
+}
+
+TEST_CASE("Gradients of measures")
+{
+    // quadrance in the Euclidean plane
+    using P = pg_point<D>;
+    const auto a = P {D::variable(1., 0), D::variable(2., 1), D(1.)};
+    const auto b = P {D::variable(4., 2), D::variable(6., 3), D(1.)};
+    const auto q = quadrance(a, b);
+    CHECK(q.value() == doctest::Approx(25.));
+    CHECK(q.d(0) == doctest::Approx(-6.));
+    CHECK(q.d(1) == doctest::Approx(-8.));
+    CHECK(q.d(2) == doctest::Approx(6.));
+    CHECK(q.d(3) == doctest::Approx(8.));
+
+    chk_gradient([](const auto& p, const auto& r) { return quadrance(p, r); });
+    chk_gradient([](const auto& p, const auto& r) {
+        using Q = std::remove_cvref_t<decltype(p)>;
+        return ellck<Q>().measure(p, r);
+    });
+    chk_gradient([](const auto& p, const auto& r) {
+        using Q = std::remove_cvref_t<decltype(p)>;
+        return hyck<Q>().measure(p, r);
+    });
+    chk_gradient([](const auto& p, const auto& r) {
+        using Q = std::remove_cvref_t<decltype(p)>;
+        using K = Value_type<Q>;
+        const auto myck = persp_euclid_plane {Q {K(0.), K(1.), K(1.)},
+            Q {K(1.), K(0.), K(0.)}, pg_line<K> {K(0.), K(-1.), K(1.)}};
+        return myck.measure(p, r);
+    });
+    chk_gradient([](const auto& p, const auto& r) {
+        using Q = std::remove_cvref_t<decltype(p)>;
+        using K = Value_type<Q>;
+        const auto c = Q {K(1.), K(3.), K(1.)};
+        return spread(p * c, r * c);
+    });
+}
@@ -7,7 +7,9 @@
 #include "pgcpp/pg_line.hpp"
 #include "pgcpp/pg_point.hpp"
 #include <boost/multiprecision/cpp_int.hpp>
+#include <cmath>
 #include <doctest/doctest.h>
+#include <vector>
 // #include <iostream>
 
 using namespace fun;
@@ -207,3 +209,72 @@ TEST_CASE("Euclid Cyclic Points (double)")
         std::tuple {std::move(u1), std::move(u2), std::move(u3), std::move(u4)};
     chk_cyclic(quadangle);
 }
+
+TEST_CASE("Euclid quadrance all pairs")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+    using Q = Fraction<cpp_int>;
+
+    const auto a = P {1, 3, 2};
+    const auto b = P {-4, 2, 3};
+    CHECK(quadrance(a, b) ==
+        quad1(a[0], a[2], b[0], b[2]) + quad1(a[1], a[2], b[1], b[2]));
+
+    auto pts = std::vector<P> {};
+    auto ptsd = std::vector<pg_point<double>> {};
+    // more than 1024 pairs, so that chunks may start inside a row
+    for (auto i = 0; i != 48; ++i)
+    {
+        pts.emplace_back(i * i - 3, 2 * i + 1, i % 4 + 1);
+        ptsd.emplace_back(i * i - 3., 2. * i + 1., i % 4 + 1.);
+    }
+    auto out = std::vector<Q>(pts.size() * (pts.size() - 1) / 2);
+    auto outd = std::vector<double>(out.size());
+    quadrance_all_pairs(std::span<const P> {pts}, std::span<Q> {out});
+    quadrance_all_pairs(std::span<const pg_point<double>> {ptsd},
+        std::span<double> {outd});
+    auto k = 0U;
+    for (auto i = 0U; i != pts.size(); ++i)
+    {
+        for (auto j = i + 1; j != pts.size(); ++j, ++k)
+        {
+            CHECK(out[k] == quadrance(pts[i], pts[j]));
+            CHECK(outd[k] - quadrance(ptsd[i], ptsd[j]) == Zero);
+        }
+    }
+    CHECK(k == out.size());
+}
+
+TEST_CASE("Euclid distance and angle batches")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+    using L = pg_line<cpp_int>;
+
+    auto a = std::vector<P> {};
+    auto b = std::vector<P> {};
+    auto big = cpp_int(1) << 80U;
+    for (auto i = 0; i != 100; ++i)
+    {
+        a.emplace_back(big * (i + 1) + 1, big - i, big + 3);
+        b.emplace_back(i - 3, 2 * i + 1, i % 4 + 1);
+    }
+    auto l = std::vector<L> {};
+    auto m = std::vector<L> {};
+    for (auto i = 0; i != 100; ++i)
+    {
+        l.emplace_back(a[i] * b[i]);
+        m.emplace_back(b[i] * b[(i + 1) % b.size()]);
+    }
+    auto d = std::vector<double>(a.size());
+    auto t = std::vector<double>(a.size());
+    distance_all(std::span<const P> {a}, std::span<const P> {b},
+        std::span<double> {d});
+    angle_all(std::span<const L> {l}, std::span<const L> {m},
+        std::span<double> {t});
+    CHECK(d[5] == distance(a[5], b[5]));
+    CHECK(d[5] == doctest::Approx(std::hypot(5., 4.5)).epsilon(1e-12));
+    CHECK(t[7] == angle(l[7], m[7]));
+    CHECK(t[7] > 0.);
+}
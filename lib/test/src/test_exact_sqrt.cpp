@@ -0,0 +1,139 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/euclid_plane_measure.hpp"
+#include "pgcpp/exact_sqrt.hpp"
+#include "pgcpp/fractions.hpp"
+#include "pgcpp/gf_p.hpp"
+#include "pgcpp/gf_pk.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/poly.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <span>
+#include <vector>
+
+using namespace fun;
+
+TEST_CASE("Integer square roots")
+{
+    using boost::multiprecision::cpp_int;
+
+    static_assert(isqrt(99) == 9);
+    static_assert(is_square(144) && !is_square(145) && !is_square(-4));
+    auto ok = true;
+    auto filtered = 0;
+    for (auto n = 0LL; n != 20000; ++n)
+    {
+        const auto r = isqrt(n);
+        ok = ok && r * r <= n && n < (r + 1) * (r + 1);
+        ok = ok && is_square(n) == (r * r == n);
+        filtered += detail::maybe_square(n) ? 0 : 1;
+    }
+    CHECK(ok);
+    CHECK(filtered > 19000); // most non-squares never reach isqrt
+    CHECK(isqrt((1LL << 62) - 1) == (1LL << 31) - 1);
+    CHECK(is_square(4611686014132420609LL)); // (2^31 - 1)^2
+
+    const auto big = cpp_int((cpp_int(1) << 200U) + 12345);
+    const auto sq = cpp_int(big * big);
+    CHECK(isqrt(sq) == big);
+    CHECK(isqrt(cpp_int(sq - 1)) == big - 1);
+    CHECK(*exact_sqrt(sq) == big);
+    CHECK(!is_square(cpp_int(sq + 1)));
+    CHECK(!is_square(cpp_int(sq - 1)));
+}
+
+TEST_CASE("Square roots in finite fields")
+{
+    using boost::multiprecision::cpp_int;
+
+    static_assert(detail::binary_integer<long>);
+    static_assert(detail::binary_integer<cpp_int>);
+    static_assert(!detail::binary_integer<gf_p<>>);
+    static_assert(!detail::binary_integer<poly>);
+
+    // every square has a root, and no non-square has one
+    const auto sweep = [](auto zero) {
+        using F = decltype(zero);
+        const auto q = F::order();
+        auto square = std::vector<char>(q);
+        for (auto i = 0U; i != q; ++i)
+        {
+            const auto x = F::from_index(i);
+            square[F(x * x).index()] = 1;
+        }
+        auto ok = true;
+        for (auto i = 0U; i != q; ++i)
+        {
+            const auto a = F::from_index(i);
+            const auto r = exact_sqrt(a);
+            ok = ok && r.has_value() == (square[i] != 0);
+            ok = ok && (!r || F(*r * *r) == a);
+        }
+        return ok;
+    };
+    CHECK(sweep(gf_p<101> {}));
+    CHECK(sweep(gf_p<7> {}));
+    CHECK(sweep(gf_pk<3, 2> {}));
+    CHECK(sweep(gf_pk<2, 3> {}));
+    {
+        // 97 - 1 = 2^5 * 3, several rounds of Tonelli-Shanks
+        const auto field = gf_p<>::scoped_modulus {97};
+        CHECK(sweep(gf_p<> {}));
+    }
+    {
+        const auto field = gf_p<>::scoped_modulus {65537}; // 2^16 + 1
+        CHECK(sweep(gf_p<> {}));
+    }
+}
+
+TEST_CASE("Rational squares")
+{
+    using boost::multiprecision::cpp_int;
+    using Q = Fraction<cpp_int>;
+
+    CHECK(is_square(Q(cpp_int(9), cpp_int(49))));
+    CHECK(is_square(Q(cpp_int(-9), cpp_int(-49))));
+    CHECK(!is_square(Q(cpp_int(-9), cpp_int(49))));
+    CHECK(!is_square(Q(cpp_int(9), cpp_int(50))));
+    CHECK(!is_square(Q(cpp_int(8), cpp_int(49))));
+    CHECK(*exact_sqrt(Q(cpp_int(4), cpp_int(25))) == Q(cpp_int(2), cpp_int(5)));
+
+    // quadrances from the origin with rational distances: Pythagorean
+    // triples (3, 4), (5, 12), ...
+    using P = pg_point<cpp_int>;
+    const auto o = P {0, 0, 1};
+    auto pts = std::vector<P> {};
+    for (auto x = 1; x != 30; ++x)
+    {
+        for (auto y = 1; y != 30; ++y)
+        {
+            pts.emplace_back(x, y, 7);
+        }
+    }
+    auto quad = std::vector<Q> {};
+    for (const auto& p : pts)
+    {
+        quad.push_back(quadrance(o, p));
+    }
+    const auto sel = select_squares(std::span<const Q>(quad));
+    auto ok = !sel.empty();
+    auto count = 0U;
+    for (auto i = 0U; i != quad.size(); ++i)
+    {
+        const auto& p = pts[i];
+        const auto s = cpp_int(p[0] * p[0] + p[1] * p[1]);
+        const auto c = isqrt(s);
+        count += c * c == s ? 1 : 0;
+    }
+    CHECK(sel.size() == count);
+    for (const auto i : sel)
+    {
+        const auto r = *exact_sqrt(quad[i]);
+        ok = ok && r * r == quad[i] &&
+            double(r) == doctest::Approx(distance(o, pts[i]));
+    }
+    CHECK(ok);
+}
@@ -0,0 +1,85 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/euclid_plane.hpp"
+#include "pgcpp/euclid_plane_measure.hpp"
+#include "pgcpp/pg_execution.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/proj_plane_measure.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace fun;
+
+TEST_CASE("Execution policy overloads (cpp_int)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+    using L = pg_line<cpp_int>;
+    using Q = Fraction<cpp_int>;
+
+    auto pts = std::vector<P> {};
+    auto tris = std::vector<Triple<P>> {};
+    auto quads = std::vector<Quadruple<P>> {};
+    for (auto i = 0; i != 40; ++i)
+    {
+        pts.emplace_back(i, 2 * i - 5, 1 + i % 3);
+        tris.emplace_back(P {i, 1, 2}, P {-3, i, 1}, P {4, 5, i + 1});
+        // four collinear points on the line through (1, 0, 1) and (i, 1, 1)
+        const auto A = P {1, 0, 1};
+        const auto B = P {i, 1, 1};
+        quads.emplace_back(P {A}, P {B}, plucker(cpp_int(2), A, cpp_int(3), B),
+            plucker(cpp_int(-1), A, cpp_int(i + 2), B));
+    }
+    const auto n = pts.size() - 1;
+
+    auto qs = std::vector<Q>(n);
+    quadrance(execution::par, pts.begin(), pts.begin() + n, pts.begin() + 1,
+        qs.begin());
+    CHECK(qs[7] == quadrance(pts[7], pts[8]));
+
+    auto mids = std::vector<P>(n, P {0, 0, 0});
+    midpoint(execution::par_unseq, pts.begin(), pts.begin() + n,
+        pts.begin() + 1, mids.begin());
+    CHECK(mids[30] == midpoint(pts[30], pts[31]));
+
+    auto tqs = std::vector<Triple<Q>>(tris.size());
+    tri_quadrance(execution::par, tris.begin(), tris.end(), tqs.begin());
+    CHECK(tqs[5] == tri_quadrance(tris[5]));
+
+    auto trils = std::vector<Triple<L>> {};
+    for (const auto& tri : tris)
+    {
+        trils.push_back(tri_dual(tri));
+    }
+    auto tss = std::vector<Triple<Q>>(trils.size());
+    tri_spread(execution::seq, trils.begin(), trils.end(), tss.begin());
+    CHECK(tss[9] == tri_spread(trils[9]));
+    auto lns = std::vector<L> {};
+    auto mns = std::vector<L> {};
+    auto xqs = std::vector<std::tuple<P, P, L, L>> {};
+    for (const auto& [l1, l2, l3] : trils)
+    {
+        lns.emplace_back(l1);
+        mns.emplace_back(l2);
+        xqs.emplace_back(P {1, 2, 3}, P {-1, 4, 1}, L {l1}, L {l3});
+    }
+    auto ss = std::vector<Q>(lns.size());
+    spread(execution::par, lns.begin(), lns.end(), mns.begin(), ss.begin());
+    CHECK(ss[20] == spread(lns[20], mns[20]));
+    auto xs = std::vector<Q>(xqs.size());
+    x_ratio(execution::par, xqs.begin(), xqs.end(), xs.begin());
+    const auto& [xa, xb, xl, xm] = xqs[3];
+    CHECK(xs[3] == x_ratio(xa, xb, xl, xm));
+
+    auto ortho = std::vector<P>(tris.size(), P {0, 0, 0});
+    orthocenter(execution::par, tris.begin(), tris.end(), ortho.begin());
+    CHECK(ortho[11] == orthocenter(tris[11]));
+
+    auto rs = std::vector<Q>(quads.size());
+    R(execution::par, quads.begin(), quads.end(), rs.begin());
+    const auto& [A, B, C, D] = quads[12];
+    CHECK(rs[12] == R(A, B, C, D));
+}
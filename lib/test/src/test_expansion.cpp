@@ -0,0 +1,75 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/common_concepts.h"
+#include "pgcpp/expansion.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include "pgcpp/verify.hpp"
+#include <cmath>
+#include <doctest/doctest.h>
+
+using namespace fun;
+
+static_assert(ordered_ring<expansion>);
+
+TEST_CASE("Expansion arithmetic")
+{
+    const auto a = expansion {1e100};
+    const auto b = expansion {1e-100};
+    CHECK((a + b) - a == b);
+    CHECK((a + b).components().size() == 2);
+    CHECK(expansion {0.1} + expansion {0.2} != expansion {0.3});
+    CHECK(expansion {0.1} + expansion {0.2} > expansion {0.3});
+    CHECK(expansion {0.5} + expansion {0.25} == expansion {0.75});
+
+    // (1 + 2^-60)^2 = 1 + 2^-59 + 2^-120
+    const auto c = expansion {1.} + expansion {0x1p-60};
+    CHECK(c * c == expansion {1.} + expansion {0x1p-59} +
+            expansion {0x1p-120});
+    CHECK(c * c - c * c == 0.);
+    CHECK((-c).sign() == -1);
+    CHECK(double(c * c) == 1.);
+    CHECK(c * c > c);
+
+    // more components than are stored inline
+    auto d = expansion {};
+    for (auto k = -8; k != 9; ++k)
+    {
+        d += expansion {std::ldexp(1., 60 * k)};
+    }
+    CHECK(d.components().size() == 17);
+    const auto one = expansion {1.};
+    CHECK((d + one) * (d - one) == d * d - one);
+    CHECK((d + one) - one == d);
+}
+
+TEST_CASE("Exact incidence from double data")
+{
+    using P = pg_point<expansion>;
+    using Pd = pg_point<double>;
+    auto rng = verify_rng {7, 0};
+    auto exact = 0;
+    auto inexact = 0;
+    for (auto i = 0; i != 100; ++i)
+    {
+        const auto v = [&] { return rng.real() * 1e3; };
+        const auto c = std::array {v(), v(), v(), v(), v(), v(), v(), v(),
+            v(), v(), v(), v()};
+        // meet of the joins of two pairs of points
+        const auto p = (P {c[0], c[1], c[2]} * P {c[3], c[4], c[5]}) *
+            (P {c[6], c[7], c[8]} * P {c[9], c[10], c[11]});
+        exact += incident(p, P {c[0], c[1], c[2]} * P {c[3], c[4], c[5]});
+        for (auto k = 0U; k != 3; ++k)
+        {
+            CHECK(p[k].components().size() <= 8);
+        }
+        const auto pd = (Pd {c[0], c[1], c[2]} * Pd {c[3], c[4], c[5]}) *
+            (Pd {c[6], c[7], c[8]} * Pd {c[9], c[10], c[11]});
+        inexact +=
+            incident(pd, Pd {c[0], c[1], c[2]} * Pd {c[3], c[4], c[5]});
+    }
+    CHECK(exact == 100);
+    CHECK(inexact < 100);
+}
@@ -0,0 +1,83 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/finite_plane.hpp"
+#include "pgcpp/gf_p.hpp"
+#include <atomic>
+#include <cstddef>
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace fun;
+
+TEST_CASE("PG(2,7) incidence matrix")
+{
+    using F = gf_p<7>;
+    const auto plane = finite_plane<F> {};
+    REQUIRE(plane.size() == 57);
+    for (auto i = 0U; i != plane.size(); ++i)
+    {
+        CHECK(plane.index(plane.point(i)) == i);
+        CHECK(plane.index(plane.line(i)) == i);
+    }
+    const auto a = plane.point(5);
+    const auto b = plane.point(40);
+    CHECK(plane.index(a * b) == plane.index(b * a));
+
+    const auto inc = incidence_matrix {plane};
+    auto symmetric = true;
+    auto all_incident = true;
+    for (auto i = 0U; i != inc.size(); ++i)
+    {
+        const auto row = std::vector<std::size_t> {i};
+        CHECK(inc.common(row) == 8); // q + 1 points on a line
+        for (auto j = 0U; j != inc.size(); ++j)
+        {
+            symmetric = symmetric && inc.incident(i, j) == inc.incident(j, i);
+            all_incident = all_incident &&
+                inc.incident(i, j) ==
+                    (plane.point(i).dot(plane.line(j)) == F(0));
+        }
+    }
+    CHECK(symmetric);
+    CHECK(all_incident);
+
+    CHECK(inc.common(std::vector<std::size_t> {}) == plane.size());
+    // two distinct points have exactly one line in common
+    CHECK(inc.common(std::vector<std::size_t> {3, 50}) == 1);
+    const auto l = plane.index(a * b);
+    const auto pts = plane.points_on(plane.line(l));
+    CHECK(inc.collinear(std::vector {pts[0], pts[3], pts[7]}));
+    auto off = std::size_t(0);
+    while (inc.incident(off, l))
+    {
+        ++off;
+    }
+    CHECK(!inc.collinear(std::vector {pts[0], pts[3], off}));
+}
+
+TEST_CASE("PG(2,q) lines for large q")
+{
+    using F = gf_p<>;
+    const auto plane = [] {
+        const auto field = F::scoped_modulus {257};
+        return finite_plane<F> {};
+    }();
+    CHECK(plane.size() == 257U * 257U + 257U + 1U);
+    const auto field = F::scoped_modulus {11};
+    auto incidences = std::atomic<std::size_t> {0};
+    auto wrong = std::atomic<std::size_t> {0};
+    plane.for_each_line([&](std::size_t j, std::span<const std::size_t> pts) {
+        incidences += pts.size();
+        if (j % 1031 == 0)
+        {
+            for (const auto i : pts)
+            {
+                wrong += plane.point(i).dot(plane.line(j)) != F(0) ? 1 : 0;
+            }
+        }
+    });
+    CHECK(incidences == plane.size() * 258);
+    CHECK(wrong == 0);
+    CHECK(F::modulus() == 11); // the caller's field is kept
+}
@@ -69,3 +69,63 @@ TEST_CASE("Fraction Special Cases")
     // CHECK( inf + p == nan ); // ???
     // CHECK( -inf + p == nan ); // ???
 }
+
+TEST_CASE("Fraction to double")
+{
+    using boost::multiprecision::cpp_int;
+    using boost::multiprecision::cpp_rational;
+    using Q = Fraction<cpp_int>;
+
+    // x is nearest to a / b among x and its two neighbours
+    const auto nearest = [](double x, const cpp_int& a, const cpp_int& b) {
+        const auto f = cpp_rational(a, b);
+        const auto err = [&](double y) {
+            return cpp_rational(abs(cpp_rational(y) - f));
+        };
+        const auto e = err(x);
+        return e <= err(std::nextafter(x, 1e308)) &&
+            e <= err(std::nextafter(x, -1e308));
+    };
+
+    CHECK(double(Q(cpp_int(3), cpp_int(4))) == 0.75);
+    CHECK(double(Q(cpp_int(-1), cpp_int(3))) == -1. / 3.);
+    CHECK(double(Q(cpp_int(0), cpp_int(7))) == 0.);
+    CHECK(double(Q(cpp_int(1), cpp_int(0))) > 1e308);
+
+    auto all_nearest = true;
+    auto a = cpp_int(1);
+    auto b = cpp_int(1);
+    for (auto i = 0; i != 200; ++i)
+    {
+        a = a * 3 + 1;
+        b = b * 7 - i;
+        const auto x = double(Q(a, b));
+        const auto y = double(Q(b, -a));
+        all_nearest = all_nearest && nearest(x, a, b) && nearest(-y, b, a);
+    }
+    CHECK(all_nearest);
+
+    // ties to even, with and without the fast path
+    const auto two53 = cpp_int(1) << 53U;
+    CHECK(double(Q(two53 + 1, cpp_int(1))) == 0x1p53);
+    CHECK(double(Q(two53 + 3, cpp_int(1))) == 0x1p53 + 4.);
+    CHECK(double(Q((two53 + 1) * 3, cpp_int(3) << 60U)) == 0x1p-7);
+    CHECK(double(Q((two53 + 1) * 3 + 1, cpp_int(3) << 60U)) ==
+        0x1p-7 + 0x1p-59);
+
+    // subnormal and overflow
+    const auto two1074 = cpp_int(1) << 1074U;
+    CHECK(double(Q(cpp_int(1), two1074)) == 0x1p-1074);
+    CHECK(double(Q(cpp_int(3), two1074 * 2)) == 0x1p-1073);
+    CHECK(double(Q(cpp_int(1), two1074 * 2)) == 0.);
+    CHECK(double(Q(cpp_int(5), two1074 * 4)) == 0x1p-1074);
+    CHECK(double(Q(cpp_int(1) << 1100U, cpp_int(3))) > 1e308);
+
+    // builtin integers beyond 53 bits
+    using F = Fraction<long long>;
+    CHECK(double(F((1LL << 62) + 1, 3)) == 0x1p62 / 3.);
+    CHECK(double(F(-((1LL << 60) + 3), 1LL << 55)) == -32.);
+    CHECK(double(F((1LL << 54) + 3, 1LL << 54)) == 1. + 0x1p-52);
+    CHECK(nearest(double(F(9007199254740993LL, 7)),
+        cpp_int(9007199254740993LL), cpp_int(7)));
+}
@@ -0,0 +1,86 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/common_concepts.h"
+#include "pgcpp/gf_p.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include <doctest/doctest.h>
+
+using namespace fun;
+
+static_assert(Integral<gf_p<7>>);
+static_assert(Integral<gf_p<>>);
+static_assert(gf_p<2147483647>::modulus() == 2147483647);
+
+TEST_CASE("Prime field arithmetic")
+{
+    using F = gf_p<1000003>;
+
+    const auto a = F(123456);
+    const auto b = F(-7);
+    CHECK(b.value() == 1000003 - 7);
+    CHECK((a + b).value() == 123449);
+    CHECK((a - a) == 0);
+    CHECK((a * b).value() == (1000003 - 864192) % 1000003);
+    CHECK(a * a.inv() == 1);
+    CHECK(a / b * b == a);
+    CHECK(a % b == 0);
+    CHECK(F(2).pow(1000002) == 1);
+    CHECK(-F(0) == 0);
+    CHECK(F(3) < F(5));
+    CHECK(F::from_index(42).index() == 42);
+
+    CHECK(F::order() == 1000003);
+    static_assert(F(5) * F(200001) == 1000005 % 1000003);
+}
+
+TEST_CASE("Prime field with run-time modulus")
+{
+    using F = gf_p<>;
+
+    F::set_modulus(13);
+    CHECK(F::modulus() == 13);
+    CHECK(F(5) * F(8) == 1);
+    CHECK(F(4).inv() == 10);
+    F::set_modulus(2147483629);
+    CHECK(F(-1) * F(-1) == 1);
+    CHECK(F(1U << 30U) * F(4) == F(std::int64_t(1) << 32));
+    {
+        const auto guard = F::scoped_modulus {17};
+        CHECK(F::modulus() == 17);
+        CHECK(F(4).inv() == 13);
+    }
+    CHECK(F::modulus() == 2147483629);
+}
+
+TEST_CASE("Projective plane over a prime field")
+{
+    using F = gf_p<10007>;
+    using P = pg_point<F>;
+    using L = pg_line<F>;
+
+    auto p = P {1, 3, 2};
+    auto q = P {-2, 1, -1};
+    auto r = plucker(F(3), p, F(5), q);
+    CHECK(incident(r, p * q));
+    CHECK(!incident(P {0, 0, 1}, p * q));
+
+    const auto co1 = std::tuple {P {p}, P {q}, P {r}};
+    const auto co2 = std::tuple {P {1, 0, 1}, P {0, 1, 1},
+        plucker(F(-4), P {1, 0, 1}, F(9), P {0, 1, 1})};
+    CHECK(pappus_holds(co1, co2));
+
+    const auto myck = hyck<P>();
+    const auto l = L {2, 1, 3};
+    CHECK(myck.perp(myck.perp(l)) == l);
+    const auto t = myck.altitude(p, l);
+    CHECK(myck.is_perpendicular(t, l));
+    const auto q1 = ellck<P>().measure(p, q);
+    CHECK(q1 == 1 - x_ratio(p, q, ellck<P>().perp(q), ellck<P>().perp(p)));
+
+    const auto I = involution {L {l}, P {1, 1, 1}};
+    CHECK(I(I(p)) == p);
+}
@@ -0,0 +1,107 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/common_concepts.h"
+#include "pgcpp/finite_plane.hpp"
+#include "pgcpp/gf_pk.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include <doctest/doctest.h>
+#include <tuple>
+#include <vector>
+
+using namespace fun;
+
+static_assert(Integral<gf_pk<2, 3>>);
+static_assert(Integral<gf_pk<2, 24>>);
+static_assert(gf_pk<3, 2>::order() == 9);
+
+/*!
+ * @brief Check the field axioms on all elements (or the first n)
+ *
+ * @tparam F
+ * @param[in] n
+ */
+template <typename F>
+void chk_field(std::uint32_t n)
+{
+    auto ok = true;
+    for (auto i = 1U; i != n; ++i)
+    {
+        const auto a = F::from_index(i);
+        ok = ok && a * a.inv() == F(1);
+        ok = ok && a + (-a) == F(0);
+        ok = ok && a.pow(F::order() - 1) == F(1);
+        const auto b = F::from_index((i * 7 + 3) % n);
+        const auto c = F::from_index((i * 13 + 5) % n);
+        ok = ok && a * (b + c) == a * b + a * c;
+        ok = ok && (a * b) * c == a * (b * c);
+        ok = ok && (b - c) + c == b;
+        ok = ok && b / a * a == b;
+    }
+    CHECK(ok);
+}
+
+TEST_CASE("Extension field arithmetic")
+{
+    chk_field<gf_pk<2, 1>>(2);
+    chk_field<gf_pk<2, 2>>(4);
+    chk_field<gf_pk<2, 3>>(8);
+    chk_field<gf_pk<3, 2>>(9);
+    chk_field<gf_pk<5, 3>>(125);
+    chk_field<gf_pk<7, 1>>(7);
+    chk_field<gf_pk<2, 16>>(1U << 16U);
+    chk_field<gf_pk<2, 24>>(5000); // carry-less multiplication
+
+    // GF(4) = {0, 1, w, w + 1} with w^2 = w + 1
+    using F4 = gf_pk<2, 2>;
+    CHECK(F4::polynomial() == 3);
+    const auto w = F4::from_index(2);
+    CHECK(w * w == w + F4(1));
+    CHECK(F4(3) == F4(1));
+    CHECK(F4(2) == F4(0));
+
+    using F9 = gf_pk<3, 2>;
+    CHECK(F9(-1) == F9(2));
+    CHECK(F9(5) == F9(2));
+    CHECK(F9::from_index(4) % F9(1) == F9(0));
+}
+
+TEST_CASE("Projective planes over extension fields")
+{
+    CHECK(incidence_matrix {finite_plane<gf_pk<2, 2>> {}}.size() == 21);
+    CHECK(incidence_matrix {finite_plane<gf_pk<2, 3>> {}}.size() == 73);
+    const auto plane = finite_plane<gf_pk<3, 2>> {};
+    const auto inc = incidence_matrix {plane};
+    REQUIRE(inc.size() == 91);
+    auto ok = true;
+    for (auto i = 0U; i != inc.size(); ++i)
+    {
+        ok = ok && plane.index(plane.point(i)) == i;
+        ok = ok && inc.common(std::vector<std::size_t> {i}) == 10;
+        ok = ok && inc.common(std::vector<std::size_t> {i, (i + 1) % 91}) == 1;
+    }
+    CHECK(ok);
+
+    using F = gf_pk<3, 2>;
+    using P = pg_point<F>;
+    using L = pg_line<F>;
+    const auto a = F::from_index(5);
+    auto p = P {F(1), a, F(0)};
+    auto q = P {a, F(1), F(1)};
+    auto r = P {F(0), F(2), a * a};
+    const auto tri = std::tuple {P {p}, P {q}, P {r}};
+    const auto [l1, l2, l3] = tri_dual(tri);
+    CHECK(incident(p, l2));
+    CHECK(incident(p, l3));
+    CHECK(incident(q, l1));
+
+    const auto c = plucker(a, p, F(1), q);
+    const auto d = harm_conj(p, q, c);
+    CHECK(incident(d, p * q));
+    CHECK(harm_conj(p, q, d) == c);
+
+    const auto I = involution {L {F(1), F(1), a}, P {a, F(0), F(1)}};
+    CHECK(I(I(r)) == r);
+}
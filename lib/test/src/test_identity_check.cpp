@@ -0,0 +1,86 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/identity_check.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include <doctest/doctest.h>
+#include <span>
+#include <vector>
+
+using namespace fun;
+
+/*!
+ * @brief Pappus configuration from 16 variables, with the last point of
+ *        the second triple collinear or not
+ *
+ * @param[in] x
+ * @param[in] collinear
+ * @return G.(H x I), zero if G, H, I are collinear
+ */
+template <ring K>
+auto pappus_det(std::span<const K> x, bool collinear) -> K
+{
+    using P = pg_point<K>;
+    const auto pt = [&](std::size_t i) { return P {x[i], x[i + 1], x[i + 2]}; };
+    const auto A = pt(0);
+    const auto B = pt(3);
+    const auto C = plucker(x[6], A, x[7], B);
+    const auto D = pt(8);
+    const auto E = pt(11);
+    const auto F = collinear ? plucker(x[14], D, x[15], E)
+                             : P {x[14], x[15], x[14] + x[15] + K(1)};
+    const auto G = (A * E) * (B * D);
+    const auto H = (A * F) * (C * D);
+    const auto I = (B * F) * (C * E);
+    return G.dot(H * I);
+}
+
+TEST_CASE("Schwartz-Zippel identity check")
+{
+    using K = gf_p<>;
+    const auto pappus = [](std::span<const K> x) {
+        return pappus_det(x, true);
+    };
+    const auto rep = check_identity(pappus, 16, 16);
+    CHECK(rep.holds());
+    CHECK(rep.trials == 8);
+    CHECK(rep.log2_error < -8 * 25.);
+
+    const auto wrong = [](std::span<const K> x) {
+        return pappus_det(x, false);
+    };
+    K::set_modulus(13);
+    const auto bad = check_identity(wrong, 16, 16);
+    CHECK(K::modulus() == 13); // the caller's prime is kept
+    REQUIRE(!bad.holds());
+    const auto& ce = *bad.counterexample;
+    CHECK(ce.trial == 0);
+    // the counterexample can be re-evaluated
+    K::set_modulus(ce.prime);
+    auto x = std::vector<K> {};
+    for (const auto v : ce.point)
+    {
+        x.push_back(K(v));
+    }
+    CHECK(wrong(std::span<const K>(x)) != K(0));
+
+    // sine law of the elliptic plane, with fractions
+    const auto sine_law = [](std::span<const K> x) {
+        using P = pg_point<K>;
+        const auto tri = Triple<P> {P {x[0], x[1], x[2]},
+            P {x[3], x[4], x[5]}, P {x[6], x[7], x[8]}};
+        const auto myck = ellck<P>();
+        const auto [q1, q2, q3] = myck.tri_quadrance(tri);
+        const auto [s1, s2, s3] = myck.tri_spread(tri_dual(tri));
+        return std::vector {s1 * q2 - s2 * q1, s2 * q3 - s3 * q2};
+    };
+    auto opt = identity_options {};
+    opt.trials = 4;
+    const auto rep2 = check_identity(sine_law, 9, 48, opt);
+    CHECK(rep2.holds());
+    CHECK(rep2.trials + rep2.degenerate == 4);
+    CHECK(rep2.error() < 1e-20);
+}
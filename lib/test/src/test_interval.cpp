@@ -0,0 +1,115 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/common_concepts.h"
+#include "pgcpp/euclid_plane.hpp"
+#include "pgcpp/fractions.hpp"
+#include "pgcpp/interval.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include "pgcpp/proj_plane_measure.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <limits>
+#include <tuple>
+
+using namespace fun;
+
+using I = interval<double>;
+static_assert(ordered_ring<I>);
+
+TEST_CASE("Interval arithmetic")
+{
+    const auto a = I {0.1};
+    const auto s = a + I {0.2};
+    CHECK(s.lo() < s.hi()); // 0.1 + 0.2 is inexact
+    CHECK(s.width() <= 2 * std::numeric_limits<double>::epsilon());
+    CHECK(I {0.5} + I {0.25} == I {0.75}); // exact
+    const auto r = I {3.} * I {-2., 1.};
+    CHECK(r.lo() == -6.);
+    CHECK(r.hi() == 3.);
+    CHECK((I {1.} / I {3.}).contains(1. / 3.));
+    CHECK(I {1.} / I {3.} * I {3.} != I {1.});
+    CHECK((I {1.} / I {3.} * I {3.}).contains(1.));
+    CHECK(std::isinf((I {1.} / I {-1., 1.}).hi()));
+    CHECK(sqrt(I {2.}).contains(std::sqrt(2.)));
+    CHECK(abs(I {-1., 2.}).lo() == 0.);
+    CHECK(I {-1., 2.} != I {-1., 2.}); // not certainly equal
+
+    CHECK(I {1.} < I {2.});
+    CHECK(!(I {1., 3.} < I {2.}));
+    CHECK(!(I {1., 3.} > I {2.}));
+    CHECK(std::is_neq(I {1., 3.} <=> I {2.}));
+    CHECK(!std::is_lt(I {1., 3.} <=> I {2.}));
+
+    CHECK(certainly_zero(I {0.}));
+    CHECK(!certainly_zero(I {0.1, 0.2}));
+    CHECK(boost::logic::indeterminate(certainly_zero(I {-0.1, 0.2})));
+
+    // products and quotients that underflow are still enclosed
+    const auto tiny = I {1e-200} * I {1e-200};
+    CHECK(tiny.lo() == 0.);
+    CHECK(tiny.hi() > 0.);
+    CHECK(boost::logic::indeterminate(certainly_zero(tiny)));
+    CHECK((I {1e-300} / I {1e300}).hi() > 0.);
+    CHECK((I {-1e-300} * I {1e-300}).lo() < 0.);
+    CHECK(I {0.} * I {1e-200} == I {0.}); // exact zero stays exact
+
+    // 0 * inf and inf - inf could be anything
+    const auto whole = (I {1.} / I {-1., 1.}) * I {0.};
+    CHECK(whole.lo() == -std::numeric_limits<double>::infinity());
+    CHECK(whole.hi() == std::numeric_limits<double>::infinity());
+    CHECK(boost::logic::indeterminate(certainly_zero(whole)));
+    const auto inf = std::numeric_limits<double>::infinity();
+    CHECK(boost::logic::indeterminate(certainly_zero(I {inf} - I {inf})));
+    CHECK(boost::logic::indeterminate(
+        certainly_zero(I {std::numeric_limits<double>::quiet_NaN()})));
+}
+
+TEST_CASE("Certified measures and incidence")
+{
+    using boost::multiprecision::cpp_int;
+    using boost::multiprecision::cpp_rational;
+    using P = pg_point<I>;
+    using Pz = pg_point<cpp_int>;
+
+    // the same points in double and scaled to integers
+    const auto e = std::ldexp(1., -40);
+    const auto a = P {1. + e, 3., 5.};
+    const auto b = P {-2., 7. - e, 1.};
+    const auto big = cpp_int(1) << 40;
+    const auto az = Pz {big + 1, 3 * big, 5 * big};
+    const auto bz = Pz {-2 * big, 7 * big - 1, big};
+
+    const auto q = ellck<P>().measure(a, b);
+    const auto qz = ellck<Pz>().measure(az, bz);
+    const auto exact = cpp_rational(qz.num(), qz.den());
+    CHECK(cpp_rational(q.lo()) <= exact);
+    CHECK(exact <= cpp_rational(q.hi()));
+    CHECK(q.width() < 1e-12);
+
+    // cross ratio of four collinear points
+    const auto c1 = plucker(I {2.}, a, I {3.}, b);
+    const auto d1 = plucker(I {-1.}, a, I {4.}, b);
+    const auto rz = R(az, bz, plucker(cpp_int(2), az, cpp_int(3), bz),
+        plucker(cpp_int(-1), az, cpp_int(4), bz));
+    const auto r = R(a, b, c1, d1);
+    const auto exact_r = cpp_rational(rz.num()) / cpp_rational(rz.den());
+    CHECK(cpp_rational(r.lo()) <= exact_r);
+    CHECK(exact_r <= cpp_rational(r.hi()));
+    CHECK(r.width() < 1e-12);
+
+    const auto c = P {0.3, -0.7, 1.};
+    const auto t = orthocenter(std::tuple {P {a}, P {b}, P {c}});
+    CHECK(enclosure_width(t) < 1e-9);
+
+    // a point on a line made of exact data, an inexact one, a clear miss
+    const auto l = a * b;
+    CHECK(certified_incident(plucker(I {2.}, a, I {3.}, b), l));
+    const auto m = P {0.1, 0.2, 0.3} * P {0.4, 0.5, 0.6};
+    CHECK(boost::logic::indeterminate(
+        certified_incident(P {0.7, 0.8, 0.9}, m)));
+    CHECK(!certified_incident(c, l));
+}
@@ -0,0 +1,76 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/euclid_plane.hpp"
+#include "pgcpp/mesh.hpp"
+#include "pgcpp/persp_plane.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+
+using namespace fun;
+
+/*!
+ * @brief Compare mesh_measure with the per-triangle ck functions on a
+ *        triangulated 4x4 grid
+ *
+ * @param[in] myck
+ */
+template <typename PG>
+void chk_mesh(const PG& myck)
+{
+    using P = typename PG::point_t;
+
+    auto mesh = tri_mesh<P> {};
+    for (auto i = 0; i != 5; ++i)
+    {
+        for (auto j = 0; j != 5; ++j)
+        {
+            mesh.vertices.emplace_back(i + 2 * j, 3 * i - j, i + j + 7);
+        }
+    }
+    for (auto i = 0U; i != 4; ++i)
+    {
+        for (auto j = 0U; j != 4; ++j)
+        {
+            const auto v = 5 * i + j;
+            mesh.faces.push_back({v, v + 1, v + 5});
+            mesh.faces.push_back({v + 1, v + 6, v + 5});
+        }
+    }
+
+    const auto props = mesh_measure(myck, mesh);
+    CHECK(props.edges.size() == 56); // 2 * 4 * 5 + 16 diagonals
+    for (auto f = 0U; f != mesh.faces.size(); ++f)
+    {
+        const auto& [v1, v2, v3] = mesh.faces[f];
+        const auto tri = std::tuple {P {mesh.vertices[v1]},
+            P {mesh.vertices[v2]}, P {mesh.vertices[v3]}};
+        const auto [q1, q2, q3] = myck.tri_quadrance(tri);
+        const auto [s1, s2, s3] = myck.tri_spread(tri_dual(tri));
+        const auto& [e1, e2, e3] = props.face_edges[f];
+        CHECK(props.quadrances[e1] == q1);
+        CHECK(props.quadrances[e2] == q2);
+        CHECK(props.quadrances[e3] == q3);
+        CHECK(props.spreads[f][0] == s1);
+        CHECK(props.spreads[f][1] == s2);
+        CHECK(props.spreads[f][2] == s3);
+        CHECK(props.quadreas[f] == Ar(q1, q2, q3));
+    }
+}
+
+TEST_CASE("Mesh measure")
+{
+    using boost::multiprecision::cpp_int;
+
+    chk_mesh(ellck<pg_point<cpp_int>>());
+    chk_mesh(hyck<pg_point<cpp_int>>());
+
+    auto Ire = pg_point<cpp_int> {0, 1, 1};
+    auto Iim = pg_point<cpp_int> {1, 0, 0};
+    auto l_inf = pg_line<cpp_int> {0, -1, 1};
+    chk_mesh(
+        persp_euclid_plane {std::move(Ire), std::move(Iim), std::move(l_inf)});
+}
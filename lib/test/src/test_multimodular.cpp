@@ -0,0 +1,86 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/multimodular.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace fun;
+
+TEST_CASE("Multi-modular evaluation")
+{
+    using boost::multiprecision::cpp_int;
+
+    CHECK(miller_rabin_u32(2147483647));
+    CHECK(!miller_rabin_u32(2147483647U - 2U)); // 3 * 715827881
+    CHECK(!miller_rabin_u32(3215031751U)); // strong pseudoprime to 2,3,5,7
+    const auto primes = crt_primes(3);
+    CHECK(primes[0] == 2147483647);
+    CHECK(primes[1] == 2147483629);
+
+    // coordinates of about 100 bits
+    const auto big = cpp_int(1) << 100;
+    const auto a = pg_point<cpp_int> {big + 3, -big / 7, cpp_int(5)};
+    const auto b = pg_point<cpp_int> {cpp_int(-11), big - 1, big / 3};
+    const auto c = pg_point<cpp_int> {big / 5, cpp_int(17), -big};
+    const auto d = pg_point<cpp_int> {cpp_int(2), cpp_int(-3), big + 1};
+
+    // (a b) (c d), in cpp_int and modulo primes
+    const auto expected = (a * b) * (c * d);
+    const auto meet = [&] {
+        using P = pg_point<gf_p<>>;
+        const auto red = [](const pg_point<cpp_int>& p) {
+            return P {to_gf_p(p[0]), to_gf_p(p[1]), to_gf_p(p[2])};
+        };
+        return (red(a) * red(b)) * (red(c) * red(d));
+    };
+
+    auto opt = crt_options {};
+    opt.bits = 4 * 102 + 4; // degree 4 in coordinates of 102 bits
+    const auto r1 = crt_eval(meet, opt);
+    REQUIRE(r1.has_value());
+    CHECK((*r1)[0] == expected[0]);
+    CHECK((*r1)[1] == expected[1]);
+    CHECK((*r1)[2] == expected[2]);
+
+    const auto r2 = crt_eval(meet); // until stable
+    REQUIRE(r2.has_value());
+    CHECK(*r2 == *r1);
+
+    // elliptic quadrance, a fraction of two 400-bit integers
+    const auto q = ellck<pg_point<cpp_int>>().measure(a, b);
+    const auto measure = [&] {
+        using P = pg_point<gf_p<>>;
+        const auto red = [](const pg_point<cpp_int>& p) {
+            return P {to_gf_p(p[0]), to_gf_p(p[1]), to_gf_p(p[2])};
+        };
+        return std::vector {ellck<P>().measure(red(a), red(b))};
+    };
+    const auto r3 = crt_eval_rational(measure);
+    REQUIRE(r3.has_value());
+    CHECK((*r3)[0] == q);
+
+    // with a bound on |num| |den|, e.g. (2^60 + 12345) / 7
+    const auto frac = [] {
+        return std::vector {
+            Fraction<gf_p<>>(to_gf_p((cpp_int(1) << 60) + 12345), gf_p<>(7))};
+    };
+    auto opt2 = crt_options {};
+    opt2.bits = 64;
+    const auto r4 = crt_eval_rational(frac, opt2);
+    REQUIRE(r4.has_value());
+    CHECK((*r4)[0] ==
+        Fraction<cpp_int>((cpp_int(1) << 60) + 12345, cpp_int(7)));
+
+    // the modulus of the calling thread is left as it was
+    gf_p<>::set_modulus(13);
+    crt_eval(meet, opt);
+    CHECK(gf_p<>::modulus() == 13);
+
+    opt.max_primes = 2; // not enough
+    CHECK(!crt_eval(meet, opt).has_value());
+}
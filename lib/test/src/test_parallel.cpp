@@ -0,0 +1,160 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/parallel.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include <atomic>
+#include <chrono>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace fun;
+
+TEST_CASE("Work-stealing pool")
+{
+    auto pool = work_stealing_pool {3};
+    CHECK(pool.size() == 3);
+
+    // items of very different cost, each visited exactly once
+    const auto n = 5000U;
+    auto hits = std::vector<std::atomic<int>>(n);
+    auto slots = std::atomic<unsigned> {0};
+    pool.run(
+        n,
+        [&](std::size_t slot, std::size_t first, std::size_t last) {
+            slots |= 1U << slot;
+            for (auto i = first; i != last; ++i)
+            {
+                auto x = 1U;
+                for (auto k = 0U; k != (i % 97) * 50; ++k)
+                {
+                    x = x * 3 + 1;
+                }
+                hits[i] += (x != 0) ? 1 : 2;
+            }
+        },
+        8);
+    for (const auto& h : hits)
+    {
+        CHECK(h == 1);
+    }
+    CHECK(slots < 16U);
+
+    // nested runs do not deadlock
+    auto total = std::atomic<std::size_t> {0};
+    pool.run(
+        16,
+        [&](std::size_t, std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                pool.run(
+                    100,
+                    [&](std::size_t, std::size_t lo, std::size_t hi) {
+                        total += hi - lo;
+                    },
+                    10);
+            }
+        },
+        1);
+    CHECK(total == 1600);
+}
+
+TEST_CASE("Work-stealing pool (grain and exceptions)")
+{
+    auto pool = work_stealing_pool {3};
+
+    // grain is the minimum chunk size
+    auto shortest = std::atomic<std::size_t> {1000};
+    auto total = std::atomic<std::size_t> {0};
+    pool.run(
+        1000,
+        [&](std::size_t, std::size_t first, std::size_t last) {
+            auto cur = shortest.load();
+            while (last - first < cur &&
+                !shortest.compare_exchange_weak(cur, last - first))
+            {
+            }
+            total += last - first;
+        },
+        70);
+    CHECK(total == 1000);
+    CHECK(shortest >= 70);
+
+    // the first exception reaches the caller after all chunks are settled
+    auto calls = std::atomic<int> {0};
+    auto running = std::atomic<int> {0};
+    CHECK_THROWS_AS(pool.run(
+                        1000,
+                        [&](std::size_t, std::size_t first, std::size_t) {
+                            ++running;
+                            ++calls;
+                            if (first % 3 == 0)
+                            {
+                                --running;
+                                throw std::runtime_error("bad item");
+                            }
+                            std::this_thread::sleep_for(
+                                std::chrono::microseconds(50));
+                            --running;
+                        },
+                        1),
+        std::runtime_error);
+    CHECK(running == 0);
+    CHECK(calls > 0);
+
+    // the pool is still usable
+    total = 0;
+    pool.run(
+        500,
+        [&](std::size_t, std::size_t first, std::size_t last) {
+            total += last - first;
+        },
+        1);
+    CHECK(total == 500);
+}
+
+TEST_CASE("Parallel transform (cpp_int)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+    using L = pg_line<cpp_int>;
+
+    auto pts = std::vector<P> {};
+    auto lns = std::vector<L> {};
+    for (auto i = 0; i != 300; ++i)
+    {
+        pts.emplace_back(cpp_int(i) << (i % 64), i - 7, 3);
+        lns.emplace_back(5, -i, cpp_int(i + 1) << (i % 32));
+    }
+
+    auto meets = std::vector<P>(lns.size() - 1, P {0, 0, 0});
+    par_transform(
+        std::span {lns}.first(299), std::span {lns}.last(299), meets,
+        [](const L& l, const L& m) { return l * m; }, 4);
+    CHECK(meets[123] == lns[123] * lns[124]);
+
+    const auto myck = ellck<P>();
+    auto perps = std::vector<L>(pts.size(), L {0, 0, 0});
+    par_transform(pts, perps, [&](const P& p) { return myck.perp(p); });
+    CHECK(perps[299] == myck.perp(pts[299]));
+
+    auto q = std::vector<Fraction<cpp_int>>(pts.size() - 1);
+    par_for_each(q, [](auto& x) { x = Fraction<cpp_int>(1, 2); });
+    parallel_for_scratch(
+        q.size(), [] { return cpp_int {}; },
+        [&](cpp_int& tmp, std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                tmp = pts[i][0] + 1;
+                q[i] = myck.measure(pts[i], pts[i + 1]);
+            }
+        },
+        8);
+    CHECK(q[41] == myck.measure(pts[41], pts[42]));
+}
@@ -0,0 +1,103 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/common_concepts.h"
+#include "pgcpp/fractions.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/poly.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include <doctest/doctest.h>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+using namespace fun;
+
+static_assert(Integral<poly>);
+
+TEST_CASE("Sparse polynomial arithmetic")
+{
+    const auto x = poly::var(0);
+    const auto y = poly::var(1);
+    const auto z = poly::var(2);
+
+    const auto p = (x + y) * (x - y);
+    CHECK(p == x * x - y * y);
+    CHECK(p.terms().size() == 2);
+    CHECK(p.degree() == 2);
+    CHECK((x + y) * (x + y) * (x + y) - x * x * x ==
+        3 * x * x * y + 3 * x * y * y + y * y * y);
+    CHECK(p - p == 0);
+    CHECK(p / (x + y) == x - y);
+    CHECK(p % (x + y) == 0);
+    CHECK((p + 1) % (x + y) == 1);
+
+    // ordered by the sign of the leading coefficient (lex order)
+    CHECK(x > 0);
+    CHECK(x > y * y * 100);
+    CHECK(1 - x < 0);
+    CHECK(abs(1 - x) == x - 1);
+
+    CHECK(gcd(6 * x * x * y, -4 * x * y * z + 10 * x * x) == 2 * x);
+    const auto f = Fraction<poly>(6 * x * y, -4 * x * x);
+    CHECK(f.num() == -3 * y);
+    CHECK(f.den() == 2 * x);
+
+    auto os = std::ostringstream {};
+    os << 2 * x * x * y - z + 1;
+    CHECK(os.str() == "2*x0^2*x1 - x2 + 1");
+
+    // exponents are stored in a byte each
+    const auto m = monomial::var(1, 255);
+    CHECK((m * monomial::var(0, 255)).exponent(1) == 255);
+    CHECK_THROWS_AS(m * monomial::var(1), std::overflow_error);
+    CHECK_THROWS_AS(monomial::var(7, 128) * monomial::var(7, 128),
+        std::overflow_error);
+    auto y255 = poly {1};
+    for (auto i = 0; i != 255; ++i)
+    {
+        y255 *= y;
+    }
+    CHECK(y255.degree() == 255);
+    CHECK_THROWS_AS(y255 * y, std::overflow_error);
+}
+
+TEST_CASE("Symbolic Pappus and Desargues")
+{
+    using P = pg_point<poly>;
+    const auto pt = [](std::size_t i) {
+        return P {poly::var(i), poly::var(i + 1), poly::var(i + 2)};
+    };
+
+    // 14 variables: two generic lines with three points each
+    const auto A = pt(0);
+    const auto B = pt(3);
+    const auto D = pt(6);
+    const auto E = pt(9);
+    const auto C = plucker(poly::var(12), A, poly(1), B);
+    const auto F = plucker(poly::var(13), D, poly(1), E);
+    const auto co1 = std::tuple {P {A}, P {B}, P {C}};
+    const auto co2 = std::tuple {P {D}, P {E}, P {F}};
+    CHECK(pappus_holds(co1, co2));
+
+    // triangles perspective from the origin O = (0, 0, 1), 15 variables
+    const auto O = P {poly(0), poly(0), poly(1)};
+    const auto D2 = plucker(poly::var(9), O, poly(1), A);
+    const auto E2 = plucker(poly::var(10), O, poly(1), B);
+    const auto F2 = plucker(poly::var(11), O, poly(1), D);
+    const auto tri1 = std::tuple {P {A}, P {B}, P {D}};
+    const auto tri2 = std::tuple {P {D2}, P {E2}, P {F2}};
+    CHECK(desargue_holds(tri1, tri2));
+}
+
+TEST_CASE("Symbolic triple quad formula")
+{
+    using P = pg_point<poly>;
+    const auto a = P {poly::var(0), poly::var(1), poly(1)};
+    const auto b = P {poly::var(2), poly::var(3), poly(1)};
+    const auto c = plucker(poly::var(4), a, poly(1), b);
+    const auto Q = ellck<P>().tri_quadrance(std::tuple {P {a}, P {b}, P {c}});
+    CHECK(check_cross_TQF(Q) == Fraction<poly>(0));
+}
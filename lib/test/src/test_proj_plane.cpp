@@ -4,8 +4,10 @@
 #include "pgcpp/pg_line.hpp"
 #include "pgcpp/pg_point.hpp"
 #include "pgcpp/proj_plane.hpp"
+#include "pgcpp/proj_plane_measure.hpp"
 #include <complex>
 #include <doctest/doctest.h>
+#include <vector>
 // #include <iostream>
 
 using namespace fun;
@@ -85,3 +87,42 @@ TEST_CASE("Projective Point (Special case)")
     CHECK(incident(p_nan, l));
     CHECK(incident(p_nan, l_nan));
 }
+
+TEST_CASE("Cross ratio (division free)")
+{
+    using P = pg_point<long long>;
+    using K = long long;
+
+    const auto A = P {0, 0, 1};
+    const auto B = P {1, 0, 1};
+    const auto C = P {2, 0, 1};
+    const auto D = P {3, 0, 1};
+    const auto E = P {4, 0, 1};
+
+    const auto r = R(A, B, C, D); // 4/3
+    const auto rp = R_pair(A, B, C, D);
+    CHECK(cross_ratio_equal(rp, std::pair<K, K> {r.num(), r.den()}));
+    CHECK(cross_ratio_less(rp, R_pair(A, B, C, E))); // 4/3 < 3/2
+    CHECK(!cross_ratio_less(R_pair(A, B, C, E), rp));
+    CHECK(cross_ratio_less(std::pair<K, K> {1, -2}, std::pair<K, K> {1, 3}));
+    CHECK(cross_ratio_equal(
+        A, B, C, D, P {0, 0, 2}, P {2, 0, 2}, P {4, 0, 2}, P {6, 0, 2}));
+
+    // (0, 2; 1, infinity) is harmonic
+    const auto B2 = P {2, 0, 1};
+    const auto C2 = P {1, 0, 1};
+    const auto Inf = P {1, 0, 0};
+    CHECK(cross_ratio_equal(R_pair(A, B2, C2, Inf), std::pair<K, K> {-1, 1}));
+
+    auto quads = std::vector<Quadruple<P>> {};
+    for (auto i = 0; i != 10; ++i)
+    {
+        quads.emplace_back(P {i, 1, 1}, P {i + 1, 1, 1}, P {i + 2, 1, 1},
+            P {i + 3, 1, 1});
+    }
+    auto out = std::vector<std::pair<K, K>>(quads.size());
+    R_pair(std::span<const Quadruple<P>> {quads},
+        std::span<std::pair<K, K>> {out});
+    CHECK(cross_ratio_equal(out[0], out[9]));
+    CHECK(cross_ratio_equal(out[3], rp));
+}
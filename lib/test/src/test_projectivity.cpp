@@ -0,0 +1,144 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/projectivity.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace fun;
+
+static const auto Zero = doctest::Approx(0).epsilon(0.01);
+
+/*!
+ * @brief
+ *
+ * @param[in] a
+ * @return true
+ * @return false
+ */
+template <typename T>
+inline auto ApproxZero(const T& a) -> bool
+{
+    return a[0] == Zero && a[1] == Zero && a[2] == Zero;
+}
+
+TEST_CASE("Projectivity (cpp_int)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+    using L = pg_line<cpp_int>;
+
+    const auto tau = hyck<P>().reflect(L {1, -2, 3});
+    const auto H = projectivity<P> {tau};
+    const auto a = P {3, 4, 5};
+    const auto b = P {-1, 2, 7};
+    const auto l = a * b;
+
+    CHECK(H(a) == tau(a));
+    CHECK(H(l) == tau(l));
+    CHECK(H.compose(H)(a) == a);
+    CHECK(incident(H(a), H(l)));
+    CHECK(H.inverse()(H(b)) == b);
+
+    const auto src = Quadruple<P> {P {1, 0, 0}, P {0, 1, 0}, P {0, 0, 1},
+        P {1, 1, 1}};
+    const auto dst = Quadruple<P> {P {2, 1, 1}, P {-1, 3, 1}, P {4, -2, 1},
+        P {1, 1, 2}};
+    const auto G = projectivity<P> {src, dst};
+    CHECK(G(std::get<0>(src)) == std::get<0>(dst));
+    CHECK(G(std::get<1>(src)) == std::get<1>(dst));
+    CHECK(G(std::get<2>(src)) == std::get<2>(dst));
+    CHECK(G(std::get<3>(src)) == std::get<3>(dst));
+
+    const auto GH = G.compose(H);
+    CHECK(GH(a) == G(H(a)));
+    CHECK(GH.inverse()(GH(l)) == l);
+
+    auto pts = std::vector<P> {};
+    auto lns = std::vector<L> {};
+    for (auto i = 0; i != 50; ++i)
+    {
+        pts.emplace_back(i, 2 * i - 7, 3);
+        lns.emplace_back(1, -i, i + 1);
+    }
+    auto pts2 = std::vector<P>(pts.size(), P {0, 0, 0});
+    auto lns2 = std::vector<L>(lns.size(), L {0, 0, 0});
+    GH.transform(std::span<const P> {pts}, std::span<P> {pts2});
+    GH.transform(std::span<const L> {lns}, std::span<L> {lns2});
+    CHECK(pts2[17] == GH(pts[17]));
+    CHECK(lns2[31] == GH(lns[31]));
+}
+
+TEST_CASE("Projectivity (double)")
+{
+    using P = pg_point<double>;
+    using L = pg_line<double>;
+
+    const auto tau = ellck<P>().reflect(L {0.5, -2., 3.});
+    const auto H = projectivity<P> {tau};
+    const auto a = P {3., 4., 5.};
+
+    CHECK(ApproxZero(cross(H(a), tau(a))));
+    CHECK(ApproxZero(cross(H.compose(H)(a), a)));
+    CHECK(ApproxZero(cross(H.inverse()(H(a)), a)));
+}
+
+TEST_CASE("Projectivity fitting (exact)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+    using Q = Quadruple<P>;
+
+    const auto src = Q {P {1, 0, 0}, P {0, 1, 0}, P {0, 0, 1}, P {1, 1, 1}};
+    const auto dst = Q {P {2, 4, 2}, P {-1, 3, 1}, P {4, -2, 1}, P {1, 1, 2}};
+    const auto H = fit_projectivity(src, dst);
+    REQUIRE(H.has_value());
+    CHECK(H->operator()(std::get<0>(src)) == std::get<0>(dst));
+    CHECK(H->operator()(std::get<3>(src)) == std::get<3>(dst));
+    // entries are coprime with a positive leading entry
+    auto common = cpp_int(0);
+    for (const auto& row : H->matrix())
+    {
+        for (const auto& a : row)
+        {
+            common = gcd(common, a);
+        }
+    }
+    CHECK(common == 1);
+
+    const auto bad = Q {P {1, 0, 0}, P {0, 1, 0}, P {1, 1, 0}, P {1, 1, 1}};
+    CHECK(!fit_projectivity(bad, dst).has_value());
+    CHECK(!fit_projectivity(src, bad).has_value());
+
+    using F = Fraction<cpp_int>;
+    using PF = pg_point<F>;
+    const auto half = F {cpp_int(1), cpp_int(2)};
+    const auto srcf = Quadruple<PF> {PF {F(1), F(0), F(0)},
+        PF {F(0), half, F(0)}, PF {F(0), F(0), F(1)}, PF {half, half, half}};
+    const auto dstf = Quadruple<PF> {PF {F(2), F(4), F(2)},
+        PF {F(-1), F(3), F(1)}, PF {F(4), F(-2), F(1)}, PF {half, half, F(1)}};
+    const auto Hf = fit_projectivity(srcf, dstf);
+    REQUIRE(Hf.has_value());
+    CHECK(Hf->operator()(P {0, 1, 0}) == std::get<1>(dst));
+    CHECK(Hf->operator()(P {1, 1, 1}) == std::get<3>(dst));
+
+    auto srcs = std::vector<Q> {};
+    auto dsts = std::vector<Q> {};
+    for (auto i = 1; i != 20; ++i)
+    {
+        srcs.emplace_back(src);
+        dsts.emplace_back(P {2, 4, 2}, P {-1, 3, i}, P {4, -2, 1}, P {1, 1, 2});
+    }
+    dsts.emplace_back(bad);
+    srcs.emplace_back(src);
+    auto fits = std::vector<std::optional<projectivity<P>>>(srcs.size());
+    fit_projectivity(std::span<const Q> {srcs}, std::span<const Q> {dsts},
+        std::span<std::optional<projectivity<P>>> {fits});
+    CHECK(fits[5].has_value());
+    CHECK(fits[5]->operator()(std::get<1>(src)) == std::get<1>(dsts[5]));
+    CHECK(!fits.back().has_value());
+}
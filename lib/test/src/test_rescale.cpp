@@ -0,0 +1,100 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/point_batch.hpp"
+#include "pgcpp/proj_plane.hpp"
+#include "pgcpp/rescale.hpp"
+#include "pgcpp/verify.hpp"
+#include <cmath>
+#include <doctest/doctest.h>
+#include <utility>
+
+using namespace fun;
+
+namespace
+{
+    // the last of n points, each the meet of the joins of the four before
+    template <typename Policy>
+    auto chain(int n) -> pg_point<double>
+    {
+        using P = pg_point<double>;
+        const auto step = rescaling<Policy>(
+            [](const P& a, const P& b, const P& c, const P& d) {
+                return (a * c) * (b * d);
+            });
+        auto rng = verify_rng {5, 0};
+        auto p0 = P {rng.real(), rng.real(), 1.};
+        auto p1 = P {rng.real(), rng.real(), 1.};
+        auto p2 = P {rng.real(), rng.real(), 1.};
+        auto p3 = P {rng.real(), rng.real(), 1.};
+        for (auto k = 0; k != n; ++k)
+        {
+            auto p4 = step(p0, p1, p2, p3);
+            p0 = std::move(p1);
+            p1 = std::move(p2);
+            p2 = std::move(p3);
+            p3 = std::move(p4);
+        }
+        return p3;
+    }
+
+    auto finite(const pg_point<double>& p) -> bool
+    {
+        return std::isfinite(p[0]) && std::isfinite(p[1]) &&
+            std::isfinite(p[2]) && !p.is_NaN();
+    }
+} // namespace
+
+TEST_CASE("Rescaling a construction chain")
+{
+    // rescaling by powers of two is exact
+    for (auto n = 1; n != 4; ++n)
+    {
+        const auto p = rescaled(chain<no_rescale>(n));
+        const auto q = chain<pow2_rescale>(n);
+        CHECK(p[0] == q[0]);
+        CHECK(p[1] == q[1]);
+        CHECK(p[2] == q[2]);
+    }
+    CHECK(!finite(chain<no_rescale>(40)));
+    const auto p = chain<pow2_rescale>(40);
+    CHECK(finite(p));
+    const auto m = std::max({std::abs(p[0]), std::abs(p[1]), std::abs(p[2])});
+    CHECK(m >= 0.5);
+    CHECK(m < 1.);
+}
+
+TEST_CASE("Rescaling a batch")
+{
+    using P = pg_point<double>;
+    auto rng = verify_rng {6, 0};
+    auto a = point_batch<double> {};
+    auto b = point_batch<double> {};
+    for (auto i = 0; i != 3000; ++i)
+    {
+        a.push_back(P {rng.real() * 1e200, rng.real() * 1e200, 1e200});
+        b.push_back(P {rng.real(), rng.real(), 1e-300});
+    }
+    const auto l = rescaled_join_all(a, b);
+    const auto l0 = rescaled_join_all<no_rescale>(a, b);
+    auto agree = true;
+    for (auto i = 0U; i != a.size(); ++i)
+    {
+        const auto li = l.get<pg_line<double>>(i);
+        const auto ref = rescaled(a.get<P>(i) * b.get<P>(i));
+        const auto ref0 = rescaled(l0.get<pg_line<double>>(i));
+        agree = agree && li[0] == ref[0] && li[1] == ref[1] &&
+            li[2] == ref[2] && ref0[0] == ref[0] && ref0[1] == ref[1] &&
+            ref0[2] == ref[2];
+    }
+    CHECK(agree);
+
+    auto c = a;
+    rescale(c);
+    CHECK(c.x[7] == std::ldexp(a.x[7], -665));
+    CHECK(c.z[7] == std::ldexp(1e200, -665));
+    rescale<no_rescale>(c);
+    CHECK(c.z[7] == std::ldexp(1e200, -665));
+}
@@ -0,0 +1,119 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/euclid_plane.hpp"
+#include "pgcpp/euclid_plane_measure.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/tri_batch.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace fun;
+
+/*!
+ * @brief Some triangles with small integer coordinates
+ *
+ * @param[in] n
+ * @return std::vector<Triple<P>>
+ */
+template <typename P>
+auto make_triangles(int n) -> std::vector<Triple<P>>
+{
+    using K = Value_type<P>;
+    auto tris = std::vector<Triple<P>> {};
+    for (auto i = 0; i != n; ++i)
+    {
+        tris.emplace_back(P {K(i % 7 - 3), K(2 * i % 5 + 1), K(2)},
+            P {K(i % 3 + 4), K(-i % 11), K(1)},
+            P {K(-(i % 5) - 2), K(i % 4 + 3), K(3)});
+    }
+    return tris;
+}
+
+TEST_CASE("Triangle batch (Euclid, cpp_int)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+
+    const auto tris = make_triangles<P>(100);
+    const auto batch = make_triangle_batch(std::span<const Triple<P>> {tris});
+    REQUIRE(batch.size() == 100);
+    CHECK(batch.get<P>(17) == tris[17]);
+
+    const auto Q = tri_quadrance(batch);
+    const auto S = tri_spread(batch);
+    const auto O = orthocenter(batch);
+    const auto T = tri_altitude(batch);
+    const auto M = tri_midpoint(batch);
+    const auto ok = check_sine_law(Q, S);
+    for (auto t = 0U; t != tris.size(); ++t)
+    {
+        using L = pg_line<cpp_int>;
+        const auto [q1, q2, q3] = tri_quadrance(tris[t]);
+        const auto [s1, s2, s3] = tri_spread(tri_dual(tris[t]));
+        const auto [t1, t2, t3] = tri_altitude(tris[t]);
+        const auto [m1, m2, m3] = tri_midpoint(tris[t]);
+        CHECK(Q[0][t] == q1);
+        CHECK(Q[2][t] == q3);
+        CHECK(S[1][t] == s2);
+        CHECK(O.get<P>(t) == orthocenter(tris[t]));
+        CHECK(T[0].get<L>(t) == t1);
+        CHECK(T[1].get<L>(t) == t2);
+        CHECK(T[2].get<L>(t) == t3);
+        CHECK(M[0].get<P>(t) == m1);
+        CHECK(M[1].get<P>(t) == m2);
+        CHECK(M[2].get<P>(t) == m3);
+        CHECK(ok[t] != 0);
+    }
+}
+
+TEST_CASE("Triangle batch (Euclid, double)")
+{
+    using P = pg_point<double>;
+
+    const auto tris = make_triangles<P>(3000);
+    const auto batch = make_triangle_batch(std::span<const Triple<P>> {tris});
+    const auto Q = tri_quadrance(batch);
+    const auto S = tri_spread(batch);
+    for (auto t = 0U; t < tris.size(); t += 97)
+    {
+        const auto [q1, q2, q3] = tri_quadrance(tris[t]);
+        const auto [s1, s2, s3] = tri_spread(tri_dual(tris[t]));
+        CHECK(Q[1][t] == doctest::Approx(q2));
+        CHECK(S[0][t] == doctest::Approx(s1));
+        CHECK(S[2][t] == doctest::Approx(s3));
+    }
+}
+
+TEST_CASE("Triangle batch (ck planes)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+
+    const auto tris = make_triangles<P>(50);
+    const auto batch = make_triangle_batch(std::span<const Triple<P>> {tris});
+    const auto myck = hyck<P>();
+    const auto Q = tri_quadrance(myck, batch);
+    const auto S = tri_spread(myck, batch);
+    const auto O = orthocenter(myck, batch);
+    const auto T = tri_altitude(myck, batch);
+    const auto ok = check_sine_law(Q, S);
+    for (auto t = 0U; t != tris.size(); ++t)
+    {
+        using L = pg_line<cpp_int>;
+        const auto [q1, q2, q3] = myck.tri_quadrance(tris[t]);
+        const auto [s1, s2, s3] = myck.tri_spread(tri_dual(tris[t]));
+        const auto [t1, t2, t3] = myck.tri_altitude(tris[t]);
+        CHECK(Q[1][t] == q2);
+        CHECK(S[2][t] == s3);
+        CHECK(O.get<P>(t) == myck.orthocenter(tris[t]));
+        CHECK(T[0].get<L>(t) == t1);
+        CHECK(T[2].get<L>(t) == t3);
+        CHECK((ok[t] != 0) ==
+            check_sine_law(myck.tri_quadrance(tris[t]),
+                myck.tri_spread(tri_dual(tris[t]))));
+    }
+}
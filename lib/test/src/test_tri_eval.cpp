@@ -0,0 +1,110 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/euclid_plane.hpp"
+#include "pgcpp/euclid_plane_measure.hpp"
+#include "pgcpp/persp_plane.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/tri_eval.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+
+using namespace fun;
+
+static const auto Zero = doctest::Approx(0).epsilon(0.01);
+
+/*!
+ * @brief Compare tri_eval with the separate ck functions
+ *
+ * @param[in] myck
+ */
+template <typename PG>
+void chk_tri_eval(const PG& myck)
+{
+    using P = typename PG::point_t;
+    using K = Value_type<P>;
+
+    const auto triangle = std::tuple {P {1, -2, 3}, P {4, 0, 6}, P {-7, 1, 2}};
+    const auto props = tri_eval(myck, triangle);
+    const auto& [l1, l2, l3] = props.sides;
+    const auto& [t1, t2, t3] = props.altitudes;
+    const auto [u1, u2, u3] = myck.tri_altitude(triangle);
+    const auto [q1, q2, q3] = myck.tri_quadrance(triangle);
+    const auto [s1, s2, s3] = myck.tri_spread(tri_dual(triangle));
+    const auto& [r1, r2, r3] = props.quadrances;
+    const auto& [v1, v2, v3] = props.spreads;
+
+    if constexpr (Integral<K>)
+    {
+        CHECK(l1 == std::get<0>(tri_dual(triangle)));
+        CHECK(t1 == u1);
+        CHECK(t3 == u3);
+        CHECK(props.orthocenter == myck.orthocenter(triangle));
+        CHECK(r1 == q1);
+        CHECK(r2 == q2);
+        CHECK(r3 == q3);
+        CHECK(v1 == s1);
+        CHECK(v2 == s2);
+        CHECK(v3 == s3);
+        CHECK(check_sine_law(props.quadrances, props.spreads));
+    }
+    else
+    {
+        CHECK(r1 - q1 == Zero);
+        CHECK(r3 - q3 == Zero);
+        CHECK(v2 - s2 == Zero);
+    }
+}
+
+TEST_CASE("Triangle evaluator (ck planes)")
+{
+    using boost::multiprecision::cpp_int;
+
+    chk_tri_eval(ellck<pg_point<cpp_int>>());
+    chk_tri_eval(hyck<pg_line<cpp_int>>());
+    chk_tri_eval(hyck<pg_point<double>>());
+
+    auto Ire = pg_point<cpp_int> {0, 1, 1};
+    auto Iim = pg_point<cpp_int> {1, 0, 0};
+    auto l_inf = pg_line<cpp_int> {0, -1, 1};
+    const auto P =
+        persp_euclid_plane {std::move(Ire), std::move(Iim), std::move(l_inf)};
+    chk_tri_eval(P);
+
+    const auto tri = std::tuple {pg_point<cpp_int> {1, -2, 3},
+        pg_point<cpp_int> {4, 0, 6}, pg_point<cpp_int> {-7, 1, 2}};
+    const auto props = tri_eval(P, tri);
+    CHECK(std::get<1>(props.midpoints) ==
+        P.midpoint(std::get<1>(tri), std::get<2>(tri)));
+}
+
+TEST_CASE("Triangle evaluator (Euclid)")
+{
+    using boost::multiprecision::cpp_int;
+    using P = pg_point<cpp_int>;
+
+    const auto triangle = std::tuple {P {1, 3, 1}, P {4, 2, 2}, P {4, -3, 3}};
+    const auto props = tri_eval(triangle);
+    const auto [q1, q2, q3] = tri_quadrance(triangle);
+    const auto [s1, s2, s3] = tri_spread(tri_dual(triangle));
+    const auto [m12, m23, m13] = tri_midpoint(triangle);
+    CHECK(std::get<0>(props.quadrances) == q1);
+    CHECK(std::get<1>(props.quadrances) == q2);
+    CHECK(std::get<2>(props.quadrances) == q3);
+    CHECK(std::get<0>(props.spreads) == s1);
+    CHECK(std::get<1>(props.spreads) == s2);
+    CHECK(std::get<2>(props.spreads) == s3);
+    CHECK(props.orthocenter == orthocenter(triangle));
+    CHECK(std::get<1>(props.midpoints) == m23);
+    CHECK(std::get<2>(props.altitudes) ==
+        std::get<2>(tri_altitude(triangle)));
+
+    const auto tri_d = std::tuple {
+        pg_point {1., 3., 1.}, pg_point {4., 2., 2.}, pg_point {4., -3., 3.}};
+    const auto props_d = tri_eval(tri_d);
+    CHECK(std::get<0>(props_d.quadrances) -
+            quadrance(std::get<1>(tri_d), std::get<2>(tri_d)) ==
+        Zero);
+}
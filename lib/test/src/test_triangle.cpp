@@ -0,0 +1,70 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/ck_plane.hpp"
+#include "pgcpp/persp_plane.hpp"
+#include "pgcpp/pg_line.hpp"
+#include "pgcpp/pg_point.hpp"
+#include "pgcpp/triangle.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <doctest/doctest.h>
+
+using namespace fun;
+
+/*!
+ * @brief Compare the lazy triangle with the separate ck functions, before
+ *        and after moving a vertex
+ *
+ * @param[in] myck
+ */
+template <typename PG>
+void chk_triangle(const PG& myck)
+{
+    using P = typename PG::point_t;
+
+    auto tri = triangle {myck, P {1, -2, 3}, P {4, 0, 6}, P {-7, 1, 2}};
+    const auto q1 = tri.quadrance(0); // kept when a1 moves
+    CHECK(tri.side(0) == P {4, 0, 6} * P {-7, 1, 2});
+    CHECK(tri.sine_law());
+
+    tri.set_vertex(0, P {2, 5, -1});
+    const auto fresh = std::tuple {P {2, 5, -1}, P {4, 0, 6}, P {-7, 1, 2}};
+    const auto [u1, u2, u3] = myck.tri_altitude(fresh);
+    const auto [r1, r2, r3] = myck.tri_quadrance(fresh);
+    const auto [s1, s2, s3] = myck.tri_spread(tri_dual(fresh));
+
+    CHECK(tri.quadrance(0) == q1);
+    CHECK(tri.quadrance(0) == r1);
+    CHECK(tri.quadrance(1) == r2);
+    CHECK(tri.quadrance(2) == r3);
+    CHECK(tri.spread(0) == s1);
+    CHECK(tri.spread(1) == s2);
+    CHECK(tri.spread(2) == s3);
+    CHECK(tri.altitude(0) == u1);
+    CHECK(tri.altitude(2) == u3);
+    CHECK(tri.orthocenter() == myck.orthocenter(fresh));
+    CHECK(tri.sine_law());
+}
+
+TEST_CASE("Lazy triangle")
+{
+    using boost::multiprecision::cpp_int;
+
+    chk_triangle(ellck<pg_point<cpp_int>>());
+    chk_triangle(hyck<pg_point<cpp_int>>());
+    chk_triangle(hyck<pg_line<cpp_int>>());
+
+    auto Ire = pg_point<cpp_int> {0, 1, 1};
+    auto Iim = pg_point<cpp_int> {1, 0, 0};
+    auto l_inf = pg_line<cpp_int> {0, -1, 1};
+    const auto E =
+        persp_euclid_plane {std::move(Ire), std::move(Iim), std::move(l_inf)};
+    chk_triangle(E);
+
+    using P = pg_point<cpp_int>;
+    auto tri = triangle {E, P {-1, 0, 3}, P {4, -2, 1}, P {3, -1, 1}};
+    CHECK(tri.midpoint(1) == E.midpoint(P {4, -2, 1}, P {3, -1, 1}));
+    tri.set_vertex(2, P {0, 0, 1});
+    CHECK(tri.midpoint(1) == E.midpoint(P {4, -2, 1}, P {0, 0, 1}));
+    CHECK(tri.midpoint(0) == E.midpoint(P {-1, 0, 3}, P {4, -2, 1}));
+}
@@ -0,0 +1,130 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include "pgcpp/checked_int.hpp"
+#include "pgcpp/fractions.hpp"
+#include "pgcpp/verify.hpp"
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <doctest/doctest.h>
+#include <stdexcept>
+
+using namespace fun;
+
+/*!
+ * @brief Run all theorems over coordinate type K
+ *
+ * @param[in] bound
+ */
+template <typename K>
+void chk_theorems(std::int64_t bound)
+{
+    auto opt = verify_options {};
+    opt.count = 200;
+    opt.block = 64;
+    opt.bound = bound;
+    CHECK(verify(pappus_theorem<K> {}, opt).failed == 0);
+    CHECK(verify(desargue_theorem<K> {}, opt).failed == 0);
+    CHECK(verify(sine_law_theorem<K> {}, opt).failed == 0);
+    CHECK(verify(cross_law_theorem<K> {}, opt).failed == 0);
+    CHECK(verify(cross_TQF_theorem<K> {}, opt).failed == 0);
+}
+
+TEST_CASE("Theorem verification")
+{
+    using boost::multiprecision::cpp_int;
+
+    chk_theorems<std::int64_t>(3);
+    chk_theorems<cpp_int>(1000);
+    chk_theorems<Fraction<cpp_int>>(20);
+    chk_theorems<double>(1000);
+}
+
+TEST_CASE("Theorem verification over int64_t: overflows")
+{
+    // overflowing configurations are counted apart, never as failures
+    using K = std::int64_t;
+    auto opt = verify_options {};
+    opt.count = 500;
+    const auto check = [&](const auto& thm) {
+        const auto rep = verify(thm, opt);
+        CHECK(rep.failed == 0);
+        return rep.overflowed;
+    };
+    CHECK(check(pappus_theorem<K> {}) == opt.count); // bound 100
+    CHECK(check(cross_law_theorem<K> {}) > 0);
+    CHECK(check(sine_law_theorem<Fraction<K>> {}) > 0);
+    opt.bound = 5;
+    CHECK(check(pappus_theorem<K> {}) == 0);
+    CHECK(check(cross_TQF_theorem<K> {}) < opt.count / 2);
+
+    // a callable that throws std::overflow_error itself
+    const auto thm = [](verify_rng& rng, std::int64_t, double) {
+        // overflows unless the draw is 0 or +-1
+        const auto a =
+            checked_int<K>(rng.uniform(2)) * checked_int<K>(1LL << 62);
+        return a.value() % 2 == 0;
+    };
+    const auto rep = verify(thm, opt);
+    CHECK(rep.failed == 0);
+    CHECK(rep.overflowed > 0);
+    CHECK(rep.overflowed < opt.count);
+}
+
+TEST_CASE("Checked integers")
+{
+    using Z = checked_int<std::int64_t>;
+    const auto big = Z(1LL << 62);
+    CHECK((big + Z(1)).value() == (1LL << 62) + 1);
+    CHECK_THROWS_AS(big * Z(2), std::overflow_error);
+    CHECK_THROWS_AS(Z(-big - big) - Z(1), std::overflow_error);
+    CHECK_THROWS_AS(-Z(-big - big), std::overflow_error);
+    CHECK_THROWS_AS(Z(-big - big) / Z(-1), std::overflow_error);
+    CHECK(Z(-big - big) % Z(-1) == Z(0));
+    CHECK_THROWS_AS(Z(~0ULL), std::overflow_error);
+    CHECK(gcd(Z(12), Z(-18)) == Z(6));
+    CHECK(Fraction<Z>(Z(6), Z(-4)) == Fraction<Z>(Z(-3), Z(2)));
+}
+
+TEST_CASE("Theorem verification: counterexamples and checkpoints")
+{
+    // fails on configurations whose first draw is a multiple of 5
+    const auto thm = [](verify_rng& rng, std::int64_t, double) {
+        return rng.next() % 5 != 0;
+    };
+    auto opt = verify_options {};
+    opt.seed = 42;
+    opt.count = 1000;
+    opt.block = 100;
+    const auto full = verify(thm, opt);
+    CHECK(full.checked == 1000);
+    CHECK(full.failed > 100);
+    CHECK(full.failed < 300);
+    REQUIRE(full.counterexamples.size() == opt.max_counterexamples);
+    auto rng = verify_rng {opt.seed, full.counterexamples[3]};
+    CHECK(!thm(rng, 0, 0.));
+
+    opt.checkpoint = "pgcpp_verify_test.ckpt";
+    std::remove(opt.checkpoint.c_str());
+    opt.count = 400;
+    const auto part = verify(thm, opt);
+    CHECK(part.checked == 400);
+    opt.count = 1000;
+    const auto resumed = verify(thm, opt);
+    CHECK(resumed.checked_now == 600);
+    CHECK(resumed.failed == full.failed);
+    CHECK(resumed.counterexamples == full.counterexamples);
+
+    // a checkpoint of another bound or theorem is not resumed
+    opt.bound = 7;
+    CHECK(verify(thm, opt).checked_now == 1000);
+    CHECK(verify(thm, opt).checked_now == 0);
+    const auto other = [](verify_rng&, std::int64_t, double) {
+        return true;
+    };
+    const auto fresh = verify(other, opt);
+    CHECK(fresh.checked_now == 1000);
+    CHECK(fresh.failed == 0);
+    std::remove(opt.checkpoint.c_str());
+}